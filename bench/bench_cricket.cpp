@@ -0,0 +1,113 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "datagen.h"
+
+using cricket::BirthDateIndex;
+using cricket::Cricketer;
+using cricket::Date;
+using cricket::SeasonHistory;
+
+namespace {
+
+class Squad {
+public:
+    std::vector<Cricketer*> players;
+
+    Squad(int size, int matches) { datagen::populateSquad(players, size, matches, 1); }
+    ~Squad() {
+        for (size_t i = 0; i < players.size(); ++i) delete players[i];
+    }
+};
+
+}  // namespace
+
+static void BM_DateParse(benchmark::State& state) {
+    std::string text = "1998-07-23";
+    Date date;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Date::parse(text, date));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DateParse);
+
+static void BM_RecordMatch(benchmark::State& state) {
+    SeasonHistory history;
+    int i = 0;
+    for (auto _ : state) {
+        history.record(i % 120, i % 6, (12 + i % 37) / 4.0);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["bytes_per_match"] = static_cast<double>(history.memory_bytes()) / history.matches();
+}
+BENCHMARK(BM_RecordMatch);
+
+// Last-10-innings form for every player of a synthetic 40-match season,
+// with the compacted footprint of one player-season (object and buffers,
+// excluding allocator overhead) against its uncompressed payload.
+static void BM_RecentForm(benchmark::State& state) {
+    int players = static_cast<int>(state.range(0));
+    const int matches = 40;
+    std::vector<SeasonHistory> seasons(players);
+    datagen::populateSeasons(seasons, matches, 1);
+    size_t bytes = 0;
+    for (size_t i = 0; i < seasons.size(); ++i) bytes += seasons[i].memory_bytes();
+    for (auto _ : state) {
+        double sum = 0.0;
+        for (size_t i = 0; i < seasons.size(); ++i) {
+            sum += seasons[i].recent_average_score(10) + seasons[i].recent_economy(10);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * players);
+    state.counters["bytes_per_player_season"] = static_cast<double>(bytes) / players;
+    state.counters["raw_bytes_per_player_season"] = static_cast<double>(matches * (2 * sizeof(int) + sizeof(double)));
+}
+BENCHMARK(BM_RecentForm)->Arg(10000);
+
+static void BM_AverageScoreCurve(benchmark::State& state) {
+    Squad squad(1, static_cast<int>(state.range(0)));
+    const SeasonHistory& history = squad.players[0]->get_history();
+    std::vector<double> curve;
+    for (auto _ : state) {
+        history.average_score_curve(10, curve);
+        benchmark::DoNotOptimize(curve.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_AverageScoreCurve)->Arg(40)->Arg(1000);
+
+static void BM_AgeBracketQuery(benchmark::State& state) {
+    int players = static_cast<int>(state.range(0));
+    Squad squad(players, 0);
+    BirthDateIndex index;
+    for (size_t i = 0; i < squad.players.size(); ++i) index.add(squad.players[i]);
+    Date on;
+    Date::parse("2026-01-01", on);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index.aged_between(on, 19, 22));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_AgeBracketQuery)->Arg(10000);
+
+// Adding a squad and answering the first query, which merges the additions.
+static void BM_BuildBirthDateIndex(benchmark::State& state) {
+    int players = static_cast<int>(state.range(0));
+    Squad squad(players, 0);
+    Date on;
+    Date::parse("2026-01-01", on);
+    for (auto _ : state) {
+        BirthDateIndex index;
+        for (size_t i = 0; i < squad.players.size(); ++i) index.add(squad.players[i]);
+        benchmark::DoNotOptimize(index.aged_between(on, 19, 22));
+    }
+    state.SetItemsProcessed(state.iterations() * players);
+}
+BENCHMARK(BM_BuildBirthDateIndex)->Arg(10000)->Arg(100000);
+
+BENCHMARK_MAIN();
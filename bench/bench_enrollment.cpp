@@ -0,0 +1,81 @@
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include "datagen.h"
+
+using enrollment::StudentList;
+using enrollment::SubjectList;
+
+static void BM_PopulateEnrollment(benchmark::State& state) {
+    int students = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        StudentList studentList;
+        SubjectList subjectList(studentList.getDomain());
+        datagen::populateEnrollment(studentList, subjectList, students, 200, 5, 1);
+        benchmark::DoNotOptimize(studentList.getStudents().size());
+    }
+    state.SetItemsProcessed(state.iterations() * students);
+}
+BENCHMARK(BM_PopulateEnrollment)->Arg(1000)->Arg(10000);
+
+static void BM_FindStudentByRoll(benchmark::State& state) {
+    int students = static_cast<int>(state.range(0));
+    StudentList studentList;
+    SubjectList subjectList(studentList.getDomain());
+    datagen::populateEnrollment(studentList, subjectList, students, 200, 5, 1);
+    int roll = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(studentList.findStudentByRoll(roll % students + 1));
+        roll += 7919;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FindStudentByRoll)->Arg(1000)->Arg(100000);
+
+static void BM_EnrollSubject(benchmark::State& state) {
+    StudentList studentList;
+    SubjectList subjectList(studentList.getDomain());
+    datagen::populateEnrollment(studentList, subjectList, 10000, 200, 0, 1);
+    int i = 0;
+    for (auto _ : state) {
+        enrollment::Student* student = studentList.findStudentByRoll(i % 10000 + 1);
+        enrollment::Subject* subject = subjectList.findSubjectByCode(i % 200 + 1);
+        student->enrollSubject(subject);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EnrollSubject);
+
+static void BM_StudentRosterReport(benchmark::State& state) {
+    int students = static_cast<int>(state.range(0));
+    StudentList studentList;
+    SubjectList subjectList(studentList.getDomain());
+    datagen::populateEnrollment(studentList, subjectList, students, 200, 5, 1);
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.str(std::string());
+        enrollment::printStudentSubjects(studentList, os);
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * students);
+}
+BENCHMARK(BM_StudentRosterReport)->Arg(1000)->Arg(10000);
+
+static void BM_SubjectRosterReport(benchmark::State& state) {
+    int students = static_cast<int>(state.range(0));
+    StudentList studentList;
+    SubjectList subjectList(studentList.getDomain());
+    datagen::populateEnrollment(studentList, subjectList, students, 200, 5, 1);
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.str(std::string());
+        enrollment::printSubjectStudents(subjectList, os);
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * students);
+}
+BENCHMARK(BM_SubjectRosterReport)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "datagen.h"
+
+using circulation::Library;
+using circulation::Status;
+
+static void BM_PopulateLibrary(benchmark::State& state) {
+    int titles = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Library library;
+        datagen::populateLibrary(library, titles, 3, titles / 2, 1);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * titles * 3);
+}
+BENCHMARK(BM_PopulateLibrary)->Arg(1000)->Arg(10000);
+
+// Issue followed by return of the same copy, so the library returns to its
+// starting state every iteration. Each cycle still appends a transaction that
+// later returns have to scan, so the library is rebuilt (untimed) every
+// kCycleRebuild iterations to keep the per-iteration cost independent of the
+// iteration count.
+static const int kCycleRebuild = 1000;
+
+static void BM_IssueReturnCycle(benchmark::State& state) {
+    int members = static_cast<int>(state.range(0));
+    std::unique_ptr<Library> library;
+    std::vector<std::string> memberIds(members), bookIds(1000);
+    for (int m = 0; m < members; ++m) memberIds[m] = datagen::memberId(m);
+    for (int t = 0; t < 1000; ++t) bookIds[t] = datagen::bookId(t);
+    int i = 0;
+    for (auto _ : state) {
+        if (i % kCycleRebuild == 0) {
+            state.PauseTiming();
+            library.reset(new Library);
+            datagen::populateLibrary(*library, 1000, 3, members, 1);
+            state.ResumeTiming();
+        }
+        const std::string& member = memberIds[i % members];
+        const std::string& book = bookIds[i % 1000];
+        int serial = 0;
+        Status issued = library->issueBook(member, book, &serial);
+        Status returned = library->returnBook(member, book, serial);
+        benchmark::DoNotOptimize(issued);
+        benchmark::DoNotOptimize(returned);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_IssueReturnCycle)->Arg(100)->Arg(1000);
+
+// Return against a log that already holds the given number of open issues,
+// all held by faculty members (every tenth member, ten books each). Each
+// iteration appends one more transaction, so the library is rebuilt
+// (untimed) before the log has grown by a tenth.
+static void BM_ReturnBookWithHistory(benchmark::State& state) {
+    int history = static_cast<int>(state.range(0));
+    int holders = history / 10 + 1;
+    std::unique_ptr<Library> library;
+    std::string faculty = datagen::memberId(holders * 10);
+    std::string book = datagen::bookId(history);
+    int i = 0;
+    for (auto _ : state) {
+        if (i % (history / 10) == 0) {
+            state.PauseTiming();
+            library.reset(new Library);
+            datagen::populateLibrary(*library, history + 1, 1, (holders + 1) * 10, 1);
+            for (int k = 0; k < history; ++k) {
+                library->issueBook(datagen::memberId(k / 10 * 10), datagen::bookId(k));
+            }
+            state.ResumeTiming();
+        }
+        library->issueBook(faculty, book);
+        benchmark::DoNotOptimize(library->returnBook(faculty, book, 1));
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReturnBookWithHistory)->Arg(1000)->Arg(10000);
+
+static void BM_IssueInvalidMember(benchmark::State& state) {
+    Library library;
+    datagen::populateLibrary(library, 1000, 3, 1000, 1);
+    std::string member = "UNKNOWN";
+    std::string book = datagen::bookId(0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(library.issueBook(member, book));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IssueInvalidMember);
+
+BENCHMARK_MAIN();
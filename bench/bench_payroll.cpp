@@ -0,0 +1,45 @@
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+
+#include "datagen.h"
+
+using payroll::Payroll;
+
+static void BM_PopulatePayroll(benchmark::State& state) {
+    int employees = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        Payroll payroll;
+        datagen::populatePayroll(payroll, employees, 1);
+        benchmark::DoNotOptimize(payroll.getEmployees().size());
+    }
+    state.SetItemsProcessed(state.iterations() * employees);
+}
+BENCHMARK(BM_PopulatePayroll)->Arg(1000)->Arg(100000);
+
+static void BM_TotalSalary(benchmark::State& state) {
+    int employees = static_cast<int>(state.range(0));
+    Payroll payroll;
+    datagen::populatePayroll(payroll, employees, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(payroll.totalSalary());
+    }
+    state.SetItemsProcessed(state.iterations() * employees);
+}
+BENCHMARK(BM_TotalSalary)->Arg(1000)->Arg(100000);
+
+static void BM_PayrollListing(benchmark::State& state) {
+    int employees = static_cast<int>(state.range(0));
+    Payroll payroll;
+    datagen::populatePayroll(payroll, employees, 1);
+    std::ostringstream os;
+    for (auto _ : state) {
+        os.str(std::string());
+        payroll.displayAll(os);
+        benchmark::DoNotOptimize(os.tellp());
+    }
+    state.SetItemsProcessed(state.iterations() * employees);
+}
+BENCHMARK(BM_PayrollListing)->Arg(1000)->Arg(10000);
+
+BENCHMARK_MAIN();
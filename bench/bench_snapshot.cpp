@@ -0,0 +1,219 @@
+/*
+Writer throughput while full reports run on another thread. Each benchmark
+takes the reader mode as its argument:
+  0  no reader
+  1  reader loops over snapshot reports, taking no lock
+  2  reader loops over the same report while holding a mutex the writer also
+     takes, which is what consistent reporting costs without snapshots
+Compare real time on a machine with a spare core; the CPU column isolates
+the writer's own cost. The library reader also checks that every snapshot
+it reads is consistent and fails the run if one is torn.
+*/
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "datagen.h"
+
+using circulation::Library;
+using circulation::Status;
+
+namespace {
+
+enum ReaderMode { kNoReader = 0, kSnapshotReader = 1, kLockedReader = 2 };
+
+// Formats the report fully but keeps nothing.
+class DiscardBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Runs report() in a loop on its own thread until destroyed.
+class Reader {
+private:
+    std::atomic<bool> stopping;
+    std::atomic<long> reports;
+    std::thread thread;
+
+public:
+    template <typename Report>
+    explicit Reader(Report report) : stopping(false), reports(0) {
+        thread = std::thread([this, report]() {
+            while (!stopping.load(std::memory_order_relaxed)) {
+                report();
+                reports.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    ~Reader() {
+        stopping.store(true);
+        thread.join();
+    }
+
+    long getReports() const { return reports.load(); }
+};
+
+}  // namespace
+
+static void BM_EnrollUnderReports(benchmark::State& state) {
+    ReaderMode mode = static_cast<ReaderMode>(state.range(0));
+    enrollment::StudentList studentList;
+    enrollment::SubjectList subjectList(studentList.getDomain());
+    datagen::populateEnrollment(studentList, subjectList, 5000, 100, 4, 1);
+    std::vector<enrollment::Student*> students;
+    std::vector<enrollment::Subject*> subjects;
+    for (int roll = 1; roll <= 5000; ++roll) students.push_back(studentList.findStudentByRoll(roll));
+    for (int code = 1; code <= 100; ++code) subjects.push_back(subjectList.findSubjectByCode(code));
+
+    std::mutex lock;
+    DiscardBuffer discard;
+    std::ostream sink(&discard);
+    std::unique_ptr<Reader> reader;
+    if (mode == kSnapshotReader) {
+        reader.reset(new Reader([&]() {
+            mvcc::Snapshot snapshot(studentList.getDomain());
+            enrollment::printStudentSubjects(studentList, snapshot, sink);
+            enrollment::printSubjectStudents(subjectList, snapshot, sink);
+        }));
+    } else if (mode == kLockedReader) {
+        reader.reset(new Reader([&]() {
+            std::lock_guard<std::mutex> guard(lock);
+            enrollment::printStudentSubjects(studentList, sink);
+            enrollment::printSubjectStudents(subjectList, sink);
+        }));
+    }
+
+    size_t i = 0;
+    for (auto _ : state) {
+        enrollment::Student* student = students[i % students.size()];
+        enrollment::Subject* subject = subjects[(i * 7) % subjects.size()];
+        if (mode == kLockedReader) {
+            std::lock_guard<std::mutex> guard(lock);
+            student->enrollSubject(subject);
+        } else {
+            student->enrollSubject(subject);
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (reader) state.counters["reports"] = static_cast<double>(reader->getReports());
+}
+BENCHMARK(BM_EnrollUnderReports)->Arg(kNoReader)->Arg(kSnapshotReader)->Arg(kLockedReader);
+
+// Issue and return of the same copy. Every cycle supersedes three versioned
+// cells, so this also exercises reclamation while snapshots are pinned. Each
+// cycle also appends a transaction that later returns scan, so the library
+// and its reader are rebuilt (untimed) every kCycleRebuild iterations; every
+// mode then sees the same bounded log whatever its iteration count.
+static const int kCycleRebuild = 1000;
+
+static void BM_IssueReturnUnderReports(benchmark::State& state) {
+    ReaderMode mode = static_cast<ReaderMode>(state.range(0));
+    const int titles = 1000;
+    const int members = 1000;
+    std::unique_ptr<Library> library;
+    std::vector<std::string> memberIds(members), bookIds(titles);
+    for (int m = 0; m < members; ++m) memberIds[m] = datagen::memberId(m);
+    for (int t = 0; t < titles; ++t) bookIds[t] = datagen::bookId(t);
+
+    std::mutex lock;
+    std::atomic<long> torn(0);
+    long reports = 0;
+    DiscardBuffer discard;
+    std::ostream sink(&discard);
+    std::unique_ptr<Reader> reader;
+    auto rebuild = [&]() {
+        if (reader) {
+            reports += reader->getReports();
+            reader.reset();
+        }
+        library.reset(new Library);
+        datagen::populateLibrary(*library, titles, 3, members, 1);
+        if (mode == kNoReader) return;
+        Library& current = *library;
+        reader.reset(new Reader([&, mode]() {
+            std::unique_lock<std::mutex> guard(lock, std::defer_lock);
+            if (mode == kLockedReader) guard.lock();
+            mvcc::Snapshot snapshot(current.getDomain());
+            current.report(snapshot, sink);
+            circulation::Totals totals = current.totals(snapshot);
+            if (totals.issuedCopies != totals.openTransactions || totals.loansHeld != totals.openTransactions) {
+                torn.fetch_add(1);
+            }
+        }));
+    };
+
+    int i = 0;
+    for (auto _ : state) {
+        if (i % kCycleRebuild == 0) {
+            state.PauseTiming();
+            rebuild();
+            state.ResumeTiming();
+        }
+        const std::string& member = memberIds[i % members];
+        const std::string& book = bookIds[(i * 7) % titles];
+        std::unique_lock<std::mutex> guard(lock, std::defer_lock);
+        if (mode == kLockedReader) guard.lock();
+        int serial = 0;
+        Status issued = library->issueBook(member, book, &serial);
+        Status returned = library->returnBook(member, book, serial);
+        benchmark::DoNotOptimize(issued);
+        benchmark::DoNotOptimize(returned);
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+    if (reader) {
+        reports += reader->getReports();
+        reader.reset();
+        state.counters["reports"] = static_cast<double>(reports);
+        if (torn.load() != 0) state.SkipWithError("snapshot report saw torn state");
+    }
+}
+BENCHMARK(BM_IssueReturnUnderReports)->Arg(kNoReader)->Arg(kSnapshotReader)->Arg(kLockedReader);
+
+static void BM_HireUnderReports(benchmark::State& state) {
+    ReaderMode mode = static_cast<ReaderMode>(state.range(0));
+    payroll::Payroll payroll;
+    datagen::populatePayroll(payroll, 5000, 1);
+
+    std::mutex lock;
+    DiscardBuffer discard;
+    std::ostream sink(&discard);
+    std::unique_ptr<Reader> reader;
+    if (mode == kSnapshotReader) {
+        reader.reset(new Reader([&]() {
+            mvcc::Snapshot snapshot(payroll.getDomain());
+            payroll.displayAll(snapshot, sink);
+        }));
+    } else if (mode == kLockedReader) {
+        reader.reset(new Reader([&]() {
+            std::lock_guard<std::mutex> guard(lock);
+            payroll.displayAll(sink);
+        }));
+    }
+
+    int i = 0;
+    for (auto _ : state) {
+        payroll::Employee* employee = new payroll::PermanentEmployee("H" + std::to_string(i), "Hire", "Engineer", 40000);
+        if (mode == kLockedReader) {
+            std::lock_guard<std::mutex> guard(lock);
+            payroll.addEmployee(employee);
+        } else {
+            payroll.addEmployee(employee);
+        }
+        ++i;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (reader) state.counters["reports"] = static_cast<double>(reader->getReports());
+}
+BENCHMARK(BM_HireUnderReports)->Arg(kNoReader)->Arg(kSnapshotReader)->Arg(kLockedReader);
+
+BENCHMARK_MAIN();
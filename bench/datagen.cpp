@@ -0,0 +1,114 @@
+#include "datagen.h"
+
+#include <cstdio>
+#include <random>
+#include <algorithm>
+
+namespace datagen {
+
+namespace {
+
+std::string formatId(char prefix, int index) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%c%06d", prefix, index);
+    return buffer;
+}
+
+}  // namespace
+
+void populateEnrollment(enrollment::StudentList& studentList, enrollment::SubjectList& subjectList,
+                        int students, int subjects, int subjectsPerStudent, unsigned seed) {
+    std::mt19937 rng(seed);
+    for (int code = 1; code <= subjects; ++code) {
+        subjectList.addSubject(code, "Subject " + std::to_string(code));
+    }
+    std::vector<int> codes(subjects);
+    for (int i = 0; i < subjects; ++i) codes[i] = i + 1;
+    int perStudent = std::min(subjectsPerStudent, subjects);
+    for (int roll = 1; roll <= students; ++roll) {
+        studentList.addStudent(roll, "Student " + std::to_string(roll));
+        enrollment::Student* student = studentList.findStudentByRoll(roll);
+        for (int i = 0; i < perStudent; ++i) {
+            std::uniform_int_distribution<int> pick(i, subjects - 1);
+            std::swap(codes[i], codes[pick(rng)]);
+            student->enrollSubject(subjectList.findSubjectByCode(codes[i]));
+        }
+    }
+}
+
+std::string bookId(int index) { return formatId('B', index); }
+std::string memberId(int index) { return formatId('M', index); }
+bool isFaculty(int index) { return index % 10 == 0; }
+
+void populateLibrary(circulation::Library& library, int titles, int copiesPerTitle, int members, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> price(100, 2000);
+    for (int t = 0; t < titles; ++t) {
+        std::string id = bookId(t);
+        for (int serial = 1; serial <= copiesPerTitle; ++serial) {
+            library.addBook(id, serial, "Title " + id, "Author " + std::to_string(t % 97), "Publisher " + std::to_string(t % 13), price(rng));
+        }
+    }
+    for (int m = 0; m < members; ++m) {
+        std::string id = memberId(m);
+        library.addMember(id, "Member " + id, id + "@example.org", "Address " + std::to_string(m), isFaculty(m));
+    }
+}
+
+void populateServerFixture(circulation::Library& library, enrollment::StudentList& studentList, enrollment::SubjectList& subjectList) {
+    populateLibrary(library, kServerTitles, 3, kServerMembers, 1);
+    populateEnrollment(studentList, subjectList, kServerStudents, kServerSubjects, 5, 1);
+}
+
+void populatePayroll(payroll::Payroll& payroll, int employees, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> basic(20000, 90000);
+    std::uniform_int_distribution<int> allowance(2000, 20000);
+    for (int e = 0; e < employees; ++e) {
+        if (e % 3 == 2) {
+            std::string id = formatId('C', e);
+            payroll.addEmployee(new payroll::ContractualEmployee(id, "Employee " + id, "Consultant", basic(rng), allowance(rng)));
+        } else {
+            std::string id = formatId('P', e);
+            payroll.addEmployee(new payroll::PermanentEmployee(id, "Employee " + id, "Engineer", basic(rng)));
+        }
+    }
+}
+
+void populateSquad(std::vector<cricket::Cricketer*>& squad, int players, int matchesPerPlayer, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> birthDay(cricket::Date(0).years_before(-20).day_number(),
+                                                cricket::Date(0).years_before(-38).day_number());
+    std::uniform_int_distribution<int> runs(0, 120);
+    std::uniform_int_distribution<int> wickets(0, 5);
+    std::uniform_int_distribution<int> conceded(12, 48);
+    for (int p = 0; p < players; ++p) {
+        std::string name = formatId('X', p);
+        cricket::Date dob(birthDay(rng));
+        cricket::Cricketer* player;
+        switch (p % 3) {
+            case 0: player = new cricket::Bowler(name, dob, 0, 0, 0.0); break;
+            case 1: player = new cricket::Batsman(name, dob, 0, 0, 0.0); break;
+            default: player = new cricket::AllRounder(name, dob, 0, 0, 0.0, 0, 0.0); break;
+        }
+        for (int m = 0; m < matchesPerPlayer; ++m) {
+            player->record_match(runs(rng), wickets(rng), conceded(rng) / 4.0);
+        }
+        squad.push_back(player);
+    }
+}
+
+void populateSeasons(std::vector<cricket::SeasonHistory>& seasons, int matchesPerPlayer, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> runs(0, 120);
+    std::uniform_int_distribution<int> wickets(0, 5);
+    std::uniform_int_distribution<int> conceded(12, 48);
+    for (size_t p = 0; p < seasons.size(); ++p) {
+        for (int m = 0; m < matchesPerPlayer; ++m) {
+            seasons[p].record(runs(rng), wickets(rng), conceded(rng) / 4.0);
+        }
+        seasons[p].compact();
+    }
+}
+
+}  // namespace datagen
@@ -0,0 +1,54 @@
+/*
+Deterministic synthetic data for the four domains, shared by the benchmarks.
+The same seed always produces the same registry.
+*/
+#ifndef BENCH_DATAGEN_H
+#define BENCH_DATAGEN_H
+
+#include <string>
+#include <vector>
+
+#include "enrollment/enrollment.h"
+#include "circulation/library.h"
+#include "payroll/payroll.h"
+#include "cricket/cricket.h"
+
+namespace datagen {
+
+// Students get rolls 1..students and subjects codes 1..subjects; each student
+// is enrolled in subjectsPerStudent distinct random subjects.
+void populateEnrollment(enrollment::StudentList& studentList, enrollment::SubjectList& subjectList,
+                        int students, int subjects, int subjectsPerStudent, unsigned seed);
+
+std::string bookId(int index);
+std::string memberId(int index);
+
+// Every tenth member is faculty; the rest are students.
+bool isFaculty(int index);
+
+// Adds titles * copiesPerTitle book copies (serials 1..copiesPerTitle) and the
+// given number of members.
+void populateLibrary(circulation::Library& library, int titles, int copiesPerTitle, int members, unsigned seed);
+
+// Registry served by rpc_server --populate and assumed by rpc_loadgen:
+// 2000 titles with 3 copies, 2000 members, 10000 students in 200 subjects.
+const int kServerTitles = 2000;
+const int kServerMembers = 2000;
+const int kServerStudents = 10000;
+const int kServerSubjects = 200;
+void populateServerFixture(circulation::Library& library, enrollment::StudentList& studentList, enrollment::SubjectList& subjectList);
+
+// Roughly two thirds permanent and one third contractual employees.
+void populatePayroll(payroll::Payroll& payroll, int employees, unsigned seed);
+
+// Appends a mix of bowlers, batsmen and all-rounders, each with
+// matchesPerPlayer matches recorded. The caller owns the returned players.
+void populateSquad(std::vector<cricket::Cricketer*>& squad, int players, int matchesPerPlayer, unsigned seed);
+
+// Records matchesPerPlayer matches from the same distributions into every
+// season and compacts it, as a closed season would be.
+void populateSeasons(std::vector<cricket::SeasonHistory>& seasons, int matchesPerPlayer, unsigned seed);
+
+}  // namespace datagen
+
+#endif
@@ -0,0 +1,320 @@
+/*
+Load generator for rpc_server. Each client thread keeps up to <depth>
+requests in flight on its own connection, mixing book issues and returns with
+enrollments and roster queries, and the run is repeated for each concurrency
+level:
+
+    rpc_loadgen (--unix <path> | --port <n> | --self-host)
+                [--concurrency 1,4,16] [--depth 8] [--requests 20000] [--json]
+
+The server must hold the datagen server fixture (rpc_server --populate);
+--self-host starts such a server in-process on a temporary Unix socket.
+*/
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <csignal>
+#include <unistd.h>
+
+#include "datagen.h"
+#include "instrument/instrument.h"
+#include "rpc/client.h"
+#include "rpc/server.h"
+
+namespace {
+
+struct Target {
+    std::string unixPath;
+    int port;
+};
+
+struct Pending {
+    uint64_t sentNanos;
+    rpc::Op op;
+    int title;
+};
+
+struct Loan {
+    int title;
+    int serial;
+};
+
+struct ThreadResult {
+    uint64_t completed;
+    uint64_t rejected;
+    uint64_t errors;
+    std::vector<uint64_t> histogram;
+
+    ThreadResult() : completed(0), rejected(0), errors(0), histogram(instrument::kBuckets, 0) {}
+};
+
+uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool connectTo(rpc::Client& client, const Target& target, std::string& error) {
+    return target.unixPath.empty() ? client.connectTcp(target.port, error) : client.connectUnix(target.unixPath, error);
+}
+
+// Each client borrows as one faculty member (limit 10) so its issues do not
+// collide with another client's limit.
+void clientLoop(const Target& target, int clientIndex, int quota, int depth, ThreadResult& result) {
+    rpc::Client client;
+    std::string error;
+    if (!connectTo(client, target, error)) {
+        std::cerr << "rpc_loadgen: " << error << "\n";
+        result.errors = static_cast<uint64_t>(quota);
+        return;
+    }
+    std::mt19937 rng(static_cast<unsigned>(clientIndex) + 1);
+    std::uniform_int_distribution<int> title(0, datagen::kServerTitles - 1);
+    std::uniform_int_distribution<int> roll(1, datagen::kServerStudents);
+    std::uniform_int_distribution<int> code(1, datagen::kServerSubjects);
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::string member = datagen::memberId(10 * (clientIndex % (datagen::kServerMembers / 10)));
+
+    std::unordered_map<uint32_t, Pending> pending;
+    std::vector<Loan> loans;
+    int outstandingIssues = 0;
+    uint32_t nextId = 1;
+    int sent = 0;
+    std::string body;
+
+    while (sent < quota || !pending.empty()) {
+        while (sent < quota && static_cast<int>(pending.size()) < depth) {
+            body.clear();
+            rpc::Writer writer(body);
+            Pending request;
+            request.title = -1;
+            int k = kind(rng);
+            if (!loans.empty() && (k < 4 || outstandingIssues + static_cast<int>(loans.size()) >= 10)) {
+                Loan loan = loans.back();
+                loans.pop_back();
+                request.op = rpc::Op::ReturnBook;
+                writer.putString(member);
+                writer.putString(datagen::bookId(loan.title));
+                writer.putI32(loan.serial);
+            } else if (k < 8 && outstandingIssues + static_cast<int>(loans.size()) < 10) {
+                request.op = rpc::Op::IssueBook;
+                request.title = title(rng);
+                writer.putString(member);
+                writer.putString(datagen::bookId(request.title));
+                ++outstandingIssues;
+            } else if (k < 9) {
+                request.op = rpc::Op::Enroll;
+                writer.putI32(roll(rng));
+                writer.putI32(code(rng));
+            } else {
+                request.op = rpc::Op::StudentSubjects;
+                writer.putI32(roll(rng));
+            }
+            request.sentNanos = nowNanos();
+            client.send(nextId, request.op, body);
+            pending[nextId++] = request;
+            ++sent;
+        }
+        if (!client.flush()) {
+            result.errors += pending.size();
+            return;
+        }
+
+        rpc::Response response;
+        if (!client.receive(response)) {
+            result.errors += pending.size();
+            return;
+        }
+        std::unordered_map<uint32_t, Pending>::iterator it = pending.find(response.id);
+        if (it == pending.end()) {
+            ++result.errors;
+            continue;
+        }
+        uint64_t latency = nowNanos() - it->second.sentNanos;
+        ++result.histogram[instrument::bucketFor(latency)];
+        ++result.completed;
+        if (response.reply == rpc::Reply::Rejected) ++result.rejected;
+        if (response.reply == rpc::Reply::BadRequest) ++result.errors;
+        if (it->second.op == rpc::Op::IssueBook) {
+            --outstandingIssues;
+            if (response.reply == rpc::Reply::Ok) {
+                rpc::Reader reader(response.body.data(), response.body.size());
+                Loan loan = {it->second.title, reader.getI32()};
+                loans.push_back(loan);
+            }
+        }
+        pending.erase(it);
+    }
+
+    // Hand the books back so the next concurrency level starts clean.
+    for (size_t i = 0; i < loans.size(); ++i) {
+        body.clear();
+        rpc::Writer writer(body);
+        writer.putString(member);
+        writer.putString(datagen::bookId(loans[i].title));
+        writer.putI32(loans[i].serial);
+        client.send(nextId++, rpc::Op::ReturnBook, body);
+    }
+    client.flush();
+    rpc::Response response;
+    for (size_t i = 0; i < loans.size(); ++i) client.receive(response);
+}
+
+uint64_t quantileMicros(const std::vector<uint64_t>& histogram, uint64_t count, double q) {
+    if (count == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < histogram.size(); ++b) {
+        seen += histogram[b];
+        if (seen > rank) return instrument::bucketLowerBound(static_cast<int>(b)) / 1000;
+    }
+    return 0;
+}
+
+// Whole-string decimal parse; false for anything else or a value below min.
+bool parseInt(const char* text, int min, int& value) {
+    char* end;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || parsed < min || parsed > INT_MAX) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// Comma-separated levels of at least 1; false if any item is not one.
+bool parseLevels(const std::string& text, std::vector<int>& levels) {
+    levels.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int level;
+        if (!parseInt(item.c_str(), 1, level)) return false;
+        levels.push_back(level);
+    }
+    return !levels.empty();
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    Target target;
+    target.port = -1;
+    bool selfHost = false;
+    bool json = false;
+    std::vector<int> levels = {1, 4, 16};
+    int depth = 8;
+    int requests = 20000;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool valid = true;
+        if (arg == "--unix" && i + 1 < argc) {
+            target.unixPath = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            valid = parseInt(argv[++i], 0, target.port) && target.port <= 65535;
+        } else if (arg == "--self-host") {
+            selfHost = true;
+        } else if (arg == "--concurrency" && i + 1 < argc) {
+            valid = parseLevels(argv[++i], levels);
+        } else if (arg == "--depth" && i + 1 < argc) {
+            valid = parseInt(argv[++i], 1, depth);
+        } else if (arg == "--requests" && i + 1 < argc) {
+            valid = parseInt(argv[++i], 1, requests);
+        } else if (arg == "--json") {
+            json = true;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "usage: " << argv[0] << " (--unix <path> | --port <n> | --self-host)"
+                      << " [--concurrency 1,4,16] [--depth 8] [--requests 20000] [--json]\n";
+            return 2;
+        }
+    }
+    if (!selfHost && target.unixPath.empty() && target.port < 0) {
+        std::cerr << "rpc_loadgen: one of --unix, --port or --self-host is required\n";
+        return 2;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+
+    circulation::Library library;
+    enrollment::StudentList studentList;
+    enrollment::SubjectList subjectList(studentList.getDomain());
+    rpc::ServerOptions options;
+    options.workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    rpc::Server server(library, studentList, subjectList, options);
+    std::thread serverThread;
+    if (selfHost) {
+        datagen::populateServerFixture(library, studentList, subjectList);
+        target.unixPath = "/tmp/oop_rpc_loadgen_" + std::to_string(getpid()) + ".sock";
+        std::string error;
+        if (!server.listenUnix(target.unixPath, error)) {
+            std::cerr << "rpc_loadgen: " << error << "\n";
+            return 1;
+        }
+        serverThread = std::thread(&rpc::Server::run, &server);
+    }
+
+    bool failed = false;
+    if (json) {
+        std::cout << "[";
+    } else {
+        std::cout << "concurrency  depth   requests   seconds        req/s    p50(us)    p99(us)   rejected     errors\n";
+    }
+    for (size_t l = 0; l < levels.size(); ++l) {
+        int concurrency = levels[l];
+        std::vector<ThreadResult> results(concurrency);
+        std::vector<std::thread> clients;
+        uint64_t start = nowNanos();
+        for (int c = 0; c < concurrency; ++c) {
+            int quota = requests / concurrency + (c < requests % concurrency ? 1 : 0);
+            clients.push_back(std::thread(clientLoop, std::cref(target), c, quota, depth, std::ref(results[c])));
+        }
+        for (size_t c = 0; c < clients.size(); ++c) clients[c].join();
+        double seconds = (nowNanos() - start) / 1e9;
+
+        ThreadResult total;
+        for (int c = 0; c < concurrency; ++c) {
+            total.completed += results[c].completed;
+            total.rejected += results[c].rejected;
+            total.errors += results[c].errors;
+            for (int b = 0; b < instrument::kBuckets; ++b) total.histogram[b] += results[c].histogram[b];
+        }
+        if (total.errors > 0 || total.completed == 0) failed = true;
+        double rate = seconds > 0 ? total.completed / seconds : 0.0;
+        uint64_t p50 = quantileMicros(total.histogram, total.completed, 0.50);
+        uint64_t p99 = quantileMicros(total.histogram, total.completed, 0.99);
+        char line[256];
+        if (json) {
+            std::snprintf(line, sizeof(line),
+                          "%s\n  {\"concurrency\":%d,\"depth\":%d,\"requests\":%llu,\"seconds\":%.4f,\"requests_per_second\":%.1f,"
+                          "\"p50_us\":%llu,\"p99_us\":%llu,\"rejected\":%llu,\"errors\":%llu}",
+                          l ? "," : "", concurrency, depth, static_cast<unsigned long long>(total.completed), seconds, rate,
+                          static_cast<unsigned long long>(p50), static_cast<unsigned long long>(p99),
+                          static_cast<unsigned long long>(total.rejected), static_cast<unsigned long long>(total.errors));
+        } else {
+            std::snprintf(line, sizeof(line), "%11d %6d %10llu %9.3f %12.0f %10llu %10llu %10llu %10llu\n", concurrency, depth,
+                          static_cast<unsigned long long>(total.completed), seconds, rate,
+                          static_cast<unsigned long long>(p50), static_cast<unsigned long long>(p99),
+                          static_cast<unsigned long long>(total.rejected), static_cast<unsigned long long>(total.errors));
+        }
+        std::cout << line;
+    }
+    if (json) std::cout << "\n]\n";
+
+    if (selfHost) {
+        server.stop();
+        serverThread.join();
+    }
+    return failed ? 1 : 0;
+}
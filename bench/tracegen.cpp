@@ -0,0 +1,137 @@
+/*
+Writes a synthetic replay trace for one of the interactive front ends:
+
+    tracegen enrollment|library|cricket <operations> [seed] > trace.txt
+
+The trace first loads a registry sized for the requested number of
+operations, then mixes mutations and queries the way the menus would.
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "datagen.h"
+
+namespace {
+
+struct Loan {
+    int member;
+    int title;
+    int serial;
+};
+
+void enrollmentTrace(int operations, std::mt19937& rng) {
+    int students = operations / 10 + 1;
+    int subjects = students / 20 + 5;
+    for (int roll = 1; roll <= students; ++roll) std::printf("student %d Student %d\n", roll, roll);
+    for (int code = 1; code <= subjects; ++code) std::printf("subject %d Subject %d\n", code, code);
+    std::uniform_int_distribution<int> roll(1, students);
+    std::uniform_int_distribution<int> code(1, subjects);
+    std::uniform_int_distribution<int> kind(0, 999);
+    for (int i = 0; i < operations; ++i) {
+        int k = kind(rng);
+        if (k == 0) {
+            std::printf("students\n");
+        } else if (k == 1) {
+            std::printf("subjects\n");
+        } else {
+            std::printf("enroll %d %d\n", roll(rng), code(rng));
+        }
+    }
+}
+
+void libraryTrace(int operations, std::mt19937& rng) {
+    int titles = operations / 20 + 1;
+    int members = operations / 20 + 1;
+    for (int t = 0; t < titles; ++t) {
+        std::string id = datagen::bookId(t);
+        for (int serial = 1; serial <= 2; ++serial) {
+            std::printf("book %s %d %d Title_%s Author_%d Publisher_%d\n", id.c_str(), serial, 100 + t % 900, id.c_str(), t % 97, t % 13);
+        }
+    }
+    for (int m = 0; m < members; ++m) {
+        std::string id = datagen::memberId(m);
+        std::printf("member %s %d Member_%s %s@example.org Address_%d\n", id.c_str(), datagen::isFaculty(m) ? 1 : 0, id.c_str(), id.c_str(), m);
+    }
+    // Mirrors the library's rules (first free copy, 2/10 book limits) so
+    // most issues succeed and every return names a copy that is out.
+    std::vector<std::vector<bool>> issued(titles, std::vector<bool>(3, false));
+    std::vector<int> held(members, 0);
+    std::vector<Loan> loans;
+    std::uniform_int_distribution<int> member(0, members - 1);
+    std::uniform_int_distribution<int> title(0, titles - 1);
+    for (int i = 0; i < operations; ++i) {
+        if (i % 2 == 1 && !loans.empty()) {
+            std::uniform_int_distribution<size_t> pick(0, loans.size() - 1);
+            size_t k = pick(rng);
+            Loan loan = loans[k];
+            loans[k] = loans.back();
+            loans.pop_back();
+            issued[loan.title][loan.serial] = false;
+            --held[loan.member];
+            std::printf("return %s %s %d\n", datagen::memberId(loan.member).c_str(), datagen::bookId(loan.title).c_str(), loan.serial);
+            continue;
+        }
+        int m = member(rng);
+        int t = title(rng);
+        std::printf("issue %s %s\n", datagen::memberId(m).c_str(), datagen::bookId(t).c_str());
+        if (held[m] >= (datagen::isFaculty(m) ? 10 : 2)) continue;
+        for (int serial = 1; serial <= 2; ++serial) {
+            if (!issued[t][serial]) {
+                issued[t][serial] = true;
+                ++held[m];
+                Loan loan = {m, t, serial};
+                loans.push_back(loan);
+                break;
+            }
+        }
+    }
+}
+
+void cricketTrace(int operations, std::mt19937& rng) {
+    std::printf("bowler Bowler 1995-03-14 0 0 0\n");
+    std::printf("batsman Batsman 1999-11-02 0 0 0\n");
+    std::printf("allrounder AllRounder 2001-06-30 0 0 0 0 0\n");
+    std::printf("pair\n");
+    const char* roles[] = {"bowler", "batsman", "allrounder"};
+    std::uniform_int_distribution<int> role(0, 2);
+    std::uniform_int_distribution<int> runs(0, 120);
+    std::uniform_int_distribution<int> wickets(0, 5);
+    std::uniform_int_distribution<int> conceded(12, 48);
+    std::uniform_int_distribution<int> kind(0, 9);
+    for (int i = 0; i < operations; ++i) {
+        int k = kind(rng);
+        if (k < 7) {
+            std::printf("match %s %d %d %g\n", roles[role(rng)], runs(rng), wickets(rng), conceded(rng) / 4.0);
+        } else if (k < 9) {
+            std::printf("form %s 10\n", roles[role(rng)]);
+        } else {
+            std::printf("aged 2026-10-19 19 30\n");
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s enrollment|library|cricket <operations> [seed]\n", argv[0]);
+        return 2;
+    }
+    int operations = std::atoi(argv[2]);
+    std::mt19937 rng(argc > 3 ? static_cast<unsigned>(std::atoi(argv[3])) : 1u);
+    if (std::strcmp(argv[1], "enrollment") == 0) {
+        enrollmentTrace(operations, rng);
+    } else if (std::strcmp(argv[1], "library") == 0) {
+        libraryTrace(operations, rng);
+    } else if (std::strcmp(argv[1], "cricket") == 0) {
+        cricketTrace(operations, rng);
+    } else {
+        std::fprintf(stderr, "unknown domain '%s'\n", argv[1]);
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,18 @@
+# Generates a trace with tracegen and replays it through a front end.
+# Expects TRACEGEN, FRONTEND, DOMAIN, OPERATIONS and TRACE to be defined.
+execute_process(COMMAND ${TRACEGEN} ${DOMAIN} ${OPERATIONS}
+    OUTPUT_FILE ${TRACE}
+    RESULT_VARIABLE generated)
+if(NOT generated EQUAL 0)
+    message(FATAL_ERROR "tracegen ${DOMAIN} failed: ${generated}")
+endif()
+execute_process(COMMAND ${FRONTEND} --replay ${TRACE}
+    OUTPUT_VARIABLE report
+    RESULT_VARIABLE replayed)
+message("${report}")
+if(NOT replayed EQUAL 0)
+    message(FATAL_ERROR "replay of ${TRACE} failed: ${replayed}")
+endif()
+if(NOT report MATCHES "Replayed [0-9]+ ops")
+    message(FATAL_ERROR "replay report missing")
+endif()
@@ -8,127 +8,60 @@ Design the classes and implement. For list consider memory data structure.
 */
 
 #include <iostream>
-#include <vector>
-#include <map>
 #include <string>
 
-class Subject;
+#include "enrollment/enrollment.h"
+#include "replay/replay.h"
 
-class Student {
-private:
-    int roll;
-    std::string name;
-    std::vector<Subject*> enrolledSubjects;
-
-public:
-    Student(int roll, const std::string& name) : roll(roll), name(name) {}
-
-    int getRoll() const { return roll; }
-    std::string getName() const { return name; }
-
-    void enrollSubject(Subject* subject);
-    const std::vector<Subject*>& getEnrolledSubjects() const {
-        return enrolledSubjects;
-    }
-};
-
-class Subject {
-private:
-    int code;
-    std::string name;
-    std::vector<Student*> enrolledStudents;
-
-public:
-    Subject(int code, const std::string& name) : code(code), name(name) {}
-
-    int getCode() const { return code; }
-    std::string getName() const { return name; }
-
-    void addStudent(Student* student) {
-        enrolledStudents.push_back(student);
-    }
-
-    const std::vector<Student*>& getEnrolledStudents() const {
-        return enrolledStudents;
-    }
-};
-
-void Student::enrollSubject(Subject* subject) {
-    enrolledSubjects.push_back(subject);
-    subject->addStudent(this);
-}
-
-class StudentList {
-private:
-    std::map<int, Student*> students;
-
-public:
-    ~StudentList() {
-        for (std::map<int, Student*>::iterator it = students.begin(); it != students.end(); ++it) {
-            delete it->second;
-        }
-    }
-
-    void addStudent(int roll, const std::string& name) {
-        if (students.find(roll) != students.end()) {
-            std::cout << "Error: A student with roll number " << roll << " already exists.\n";
-            return;
-        }
-        students[roll] = new Student(roll, name);
-    }
-
-    Student* findStudentByRoll(int roll) {
-        std::map<int, Student*>::iterator it = students.find(roll);
-        return it != students.end() ? it->second : NULL;
-    }
-
-    void listAllStudents() const {
-        for (std::map<int, Student*>::const_iterator it = students.begin(); it != students.end(); ++it) {
-            std::cout << "Roll: " << it->first << ", Name: " << it->second->getName() << "\n";
-        }
-    }
-
-    const std::map<int, Student*>& getStudents() const { return students; }
-};
-
-class SubjectList {
-private:
-    std::map<int, Subject*> subjects;
+using enrollment::Student;
+using enrollment::Subject;
+using enrollment::StudentList;
+using enrollment::SubjectList;
 
+class System {
 public:
-    ~SubjectList() {
-        for (std::map<int, Subject*>::iterator it = subjects.begin(); it != subjects.end(); ++it) {
-            delete it->second;
-        }
-    }
-
-    void addSubject(int code, const std::string& name) {
-        if (subjects.find(code) != subjects.end()) {
-            std::cout << "Error: A subject with code " << code << " already exists.\n";
-            return;
-        }
-        subjects[code] = new Subject(code, name);
-    }
-
-    Subject* findSubjectByCode(int code) {
-        std::map<int, Subject*>::iterator it = subjects.find(code);
-        return it != subjects.end() ? it->second : NULL;
-    }
+    // Headless counterpart of run(): executes a command trace with no
+    // prompts. Commands: student <roll> <name>, subject <code> <name>,
+    // enroll <roll> <code>, students, subjects.
+    static int replayTrace(const char* path) {
+        StudentList studentList;
+        SubjectList subjectList(studentList.getDomain());
+        replay::NullStream sink;
 
-    void listAllSubjects() const {
-        for (std::map<int, Subject*>::const_iterator it = subjects.begin(); it != subjects.end(); ++it) {
-            std::cout << "Code: " << it->first << ", Name: " << it->second->getName() << "\n";
-        }
+        return replay::run(path, [&](const replay::Command& command) {
+            if (command.op == "student") {
+                replay::expectTailArgs(command, 2);
+                return studentList.addStudent(replay::intArg(command, 0), replay::tailArg(command, 1));
+            }
+            if (command.op == "subject") {
+                replay::expectTailArgs(command, 2);
+                return subjectList.addSubject(replay::intArg(command, 0), replay::tailArg(command, 1));
+            }
+            if (command.op == "enroll") {
+                replay::expectArgs(command, 2);
+                Student* student = studentList.findStudentByRoll(replay::intArg(command, 0));
+                Subject* subject = subjectList.findSubjectByCode(replay::intArg(command, 1));
+                if (!student || !subject) return false;
+                student->enrollSubject(subject);
+                return true;
+            }
+            if (command.op == "students") {
+                replay::expectArgs(command, 0);
+                enrollment::printStudentSubjects(studentList, sink);
+                return true;
+            }
+            if (command.op == "subjects") {
+                replay::expectArgs(command, 0);
+                enrollment::printSubjectStudents(subjectList, sink);
+                return true;
+            }
+            replay::unknownCommand(command);
+        });
     }
 
-    const std::map<int, Subject*>& getSubjects() const { return subjects; }
-};
-
-class System {
-public:
     static void run() {
         StudentList studentList;
-        SubjectList subjectList;
+        SubjectList subjectList(studentList.getDomain());
 
         while (true) {
             std::cout << "\nMenu:\n";
@@ -152,7 +85,9 @@ public:
                     std::cin.ignore();  // Ignore newline character from previous input
                     std::cout << "Enter student name: ";
                     std::getline(std::cin, name);
-                    studentList.addStudent(roll, name);
+                    if (!studentList.addStudent(roll, name)) {
+                        std::cout << "Error: A student with roll number " << roll << " already exists.\n";
+                    }
                     break;
                 }
                 case 2: {
@@ -163,7 +98,9 @@ public:
                     std::cin.ignore();  // Ignore newline character from previous input
                     std::cout << "Enter subject name: ";
                     std::getline(std::cin, name);
-                    subjectList.addSubject(code, name);
+                    if (!subjectList.addSubject(code, name)) {
+                        std::cout << "Error: A subject with code " << code << " already exists.\n";
+                    }
                     break;
                 }
                 case 3: {
@@ -185,29 +122,13 @@ public:
                     break;
                 }
                 case 4: {
-                    const std::map<int, Student*>& students = studentList.getStudents();
-                    std::cout << "\nStudent -> Subjects:\n";
-                    for (std::map<int, Student*>::const_iterator it = students.begin(); it != students.end(); ++it) {
-                        Student* student = it->second;
-                        std::cout << "Student: " << student->getName() << " (Roll: " << student->getRoll() << ")\nSubjects:\n";
-                        const std::vector<Subject*>& subjects = student->getEnrolledSubjects();
-                        for (std::vector<Subject*>::const_iterator sit = subjects.begin(); sit != subjects.end(); ++sit) {
-                            std::cout << "  - " << (*sit)->getName() << "\n";
-                        }
-                    }
+                    mvcc::Snapshot snapshot(studentList.getDomain());
+                    enrollment::printStudentSubjects(studentList, snapshot);
                     break;
                 }
                 case 5: {
-                    const std::map<int, Subject*>& subjects = subjectList.getSubjects();
-                    std::cout << "\nSubject -> Students:\n";
-                    for (std::map<int, Subject*>::const_iterator it = subjects.begin(); it != subjects.end(); ++it) {
-                        Subject* subject = it->second;
-                        std::cout << "Subject: " << subject->getName() << " (Code: " << subject->getCode() << ")\nStudents:\n";
-                        const std::vector<Student*>& students = subject->getEnrolledStudents();
-                        for (std::vector<Student*>::const_iterator it = students.begin(); it != students.end(); ++it) {
-                            std::cout << "  - " << (*it)->getName() << "\n";
-                        }
-                    }
+                    mvcc::Snapshot snapshot(studentList.getDomain());
+                    enrollment::printSubjectStudents(subjectList, snapshot);
                     break;
                 }
                 case 6: {
@@ -221,7 +142,10 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::string(argv[1]) == "--replay") {
+        return System::replayTrace(argv[2]);
+    }
     System::run();
     return 0;
 }
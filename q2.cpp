@@ -15,188 +15,56 @@ is issued and updated when the book is returned.
 Design the classes and implement. For list consider memory data structure.
 */
 #include <iostream>
-#include <vector>
-#include <map>
 #include <string>
-#include <ctime>
 
-class Member {
-protected:
-    std::string memberId;
-    std::string name;
-    std::string email;
-    std::string address;
-    int booksIssued;
+#include "circulation/library.h"
+#include "replay/replay.h"
 
-public:
-    Member(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address)
-        : memberId(memberId), name(name), email(email), address(address), booksIssued(0) {}
-
-    virtual int getMaxBooks() const = 0;
-    std::string getMemberId() const { return memberId; }
-
-    bool canIssueMoreBooks() const { return booksIssued < getMaxBooks(); }
-
-    void issueBook() { ++booksIssued; }
-    void returnBook() { --booksIssued; }
-
-    virtual ~Member() {}
-};
-
-class Student : public Member {
-public:
-    Student(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address)
-        : Member(memberId, name, email, address) {}
-
-    int getMaxBooks() const override {
-        return 2;
-    }
-};
-
-class Faculty : public Member {
-public:
-    Faculty(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address)
-        : Member(memberId, name, email, address) {}
-
-    int getMaxBooks() const override {
-        return 10;
-    }
-};
-
-class Book {
-private:
-    std::string bookId;
-    int serialNumber;
-    std::string title;
-    std::string author;
-    std::string publisher;
-    double price;
-    bool isIssued;
-
-public:
-    Book(const std::string& bookId, int serialNumber, const std::string& title, const std::string& author, const std::string& publisher, double price)
-        : bookId(bookId), serialNumber(serialNumber), title(title), author(author), publisher(publisher), price(price), isIssued(false) {}
-
-    std::string getBookId() const { return bookId; }
-    int getSerialNumber() const { return serialNumber; }
-
-    bool checkAvailability() const { return !isIssued; }
-    void markIssued() { isIssued = true; }
-    void markReturned() { isIssued = false; }
-};
-
-class Transaction {
-private:
-    std::string memberId;
-    std::string bookId;
-    int serialNumber;
-    std::time_t date;
-    bool isReturned;
-
-public:
-    Transaction(const std::string& memberId, const std::string& bookId, int serialNumber)
-        : memberId(memberId), bookId(bookId), serialNumber(serialNumber), date(std::time(0)), isReturned(false) {}
-
-    void markReturned() { isReturned = true; }
-    bool checkTransaction(const std::string& memId, const std::string& bId, int serNum) const {
-        return memberId == memId && bookId == bId && serialNumber == serNum && !isReturned;
-    }
-};
+using circulation::Library;
+using circulation::Status;
 
-class Library {
+class System {
 private:
-    std::map<std::string, std::map<int, Book*>> books; 
-    std::map<std::string, Member*> members;
-    std::vector<Transaction*> transactions;
-
-public:
-    ~Library() {
-        for (auto& bookMap : books) {
-            for (auto& book : bookMap.second) {
-                delete book.second;
-            }
-        }
-        for (auto& member : members) {
-            delete member.second;
-        }
-        for (auto& transaction : transactions) {
-            delete transaction;
+    static void report(Status status, const char* successMessage) {
+        if (status != Status::Ok) {
+            std::cout << circulation::describe(status) << "\n";
+        } else if (successMessage) {
+            std::cout << successMessage << "\n";
         }
     }
 
-    void addBook(const std::string& bookId, int serialNumber, const std::string& title, const std::string& author, const std::string& publisher, double price) {
-        if (books[bookId].find(serialNumber) != books[bookId].end()) {
-            std::cout << "Error: Book with this ID and serial number already exists.\n";
-            return;
-        }
-        books[bookId][serialNumber] = new Book(bookId, serialNumber, title, author, publisher, price);
-    }
-
-    void addMember(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address, bool isFaculty) {
-        if (members.find(memberId) != members.end()) {
-            std::cout << "Error: Member with this ID already exists.\n";
-            return;
-        }
-        Member* member = nullptr;
-        if (isFaculty) {
-            member = new Faculty(memberId, name, email, address);
-        } else {
-            member = new Student(memberId, name, email, address);
-        }
-        members[memberId] = member;
-    }
-
-    void issueBook(const std::string& memberId, const std::string& bookId) {
-        if (members.find(memberId) == members.end()) {
-            std::cout << "Error: Invalid member ID.\n";
-            return;
-        }
-        if (books.find(bookId) == books.end()) {
-            std::cout << "Error: Book ID not found.\n";
-            return;
-        }
-        Member* member = members[memberId];
-        if (!member->canIssueMoreBooks()) {
-            std::cout << "Error: Member has reached the maximum limit of issued books.\n";
-            return;
-        }
-        for (auto& bookPair : books[bookId]) {
-            Book* book = bookPair.second;
-            if (book->checkAvailability()) {
-                book->markIssued();
-                member->issueBook();
-                transactions.push_back(new Transaction(memberId, bookId, book->getSerialNumber()));
-                std::cout << "Book issued successfully.\n";
-                return;
-            }
-        }
-        std::cout << "Error: No available copy of the book.\n";
-    }
+public:
+    // Headless counterpart of run(): executes a command trace with no
+    // prompts. Commands: book <bookId> <serial> <price> <title> <author>
+    // <publisher>, member <memberId> <isFaculty> <name> <email> <address>,
+    // issue <memberId> <bookId>, return <memberId> <bookId> <serial>.
+    // Text fields are single tokens.
+    static int replayTrace(const char* path) {
+        Library library;
 
-    void returnBook(const std::string& memberId, const std::string& bookId, int serialNumber) {
-        if (members.find(memberId) == members.end()) {
-            std::cout << "Error: Invalid member ID.\n";
-            return;
-        }
-        if (books.find(bookId) == books.end() || books[bookId].find(serialNumber) == books[bookId].end()) {
-            std::cout << "Error: Book ID or serial number not found.\n";
-            return;
-        }
-        for (auto& transaction : transactions) {
-            if (transaction->checkTransaction(memberId, bookId, serialNumber)) {
-                transaction->markReturned();
-                books[bookId][serialNumber]->markReturned();
-                members[memberId]->returnBook();
-                std::cout << "Book returned successfully.\n";
-                return;
+        return replay::run(path, [&](const replay::Command& command) {
+            Status status;
+            if (command.op == "issue") {
+                replay::expectArgs(command, 2);
+                status = library.issueBook(replay::stringArg(command, 0), replay::stringArg(command, 1));
+            } else if (command.op == "return") {
+                replay::expectArgs(command, 3);
+                status = library.returnBook(replay::stringArg(command, 0), replay::stringArg(command, 1), replay::intArg(command, 2));
+            } else if (command.op == "book") {
+                replay::expectArgs(command, 6);
+                status = library.addBook(replay::stringArg(command, 0), replay::intArg(command, 1), replay::stringArg(command, 3),
+                                         replay::stringArg(command, 4), replay::stringArg(command, 5), replay::doubleArg(command, 2));
+            } else if (command.op == "member") {
+                replay::expectArgs(command, 5);
+                status = library.addMember(replay::stringArg(command, 0), replay::stringArg(command, 2), replay::stringArg(command, 3),
+                                           replay::stringArg(command, 4), replay::intArg(command, 1) != 0);
+            } else {
+                replay::unknownCommand(command);
             }
-        }
-        std::cout << "Error: This book was not issued to this member.\n";
+            return status == Status::Ok;
+        });
     }
-};
 
-class System {
-public:
     static void run() {
         Library library;
 
@@ -231,7 +99,7 @@ public:
                     std::cout << "Enter Price: ";
                     std::cin >> price;
 
-                    library.addBook(bookId, serialNumber, title, author, publisher, price);
+                    report(library.addBook(bookId, serialNumber, title, author, publisher, price), nullptr);
                     break;
                 }
                 case 2: {
@@ -249,7 +117,7 @@ public:
                     std::cout << "Is Faculty (1/0): ";
                     std::cin >> isFaculty;
 
-                    library.addMember(memberId, name, email, address, isFaculty);
+                    report(library.addMember(memberId, name, email, address, isFaculty), nullptr);
                     break;
                 }
                 case 3: {
@@ -259,7 +127,7 @@ public:
                     std::cout << "Enter Book ID: ";
                     std::cin >> bookId;
 
-                    library.issueBook(memberId, bookId);
+                    report(library.issueBook(memberId, bookId), "Book issued successfully.");
                     break;
                 }
                 case 4: {
@@ -273,7 +141,7 @@ public:
                     std::cout << "Enter Serial Number: ";
                     std::cin >> serialNumber;
 
-                    library.returnBook(memberId, bookId, serialNumber);
+                    report(library.returnBook(memberId, bookId, serialNumber), "Book returned successfully.");
                     break;
                 }
                 case 5: {
@@ -287,7 +155,10 @@ public:
     }
 };
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc == 3 && std::string(argv[1]) == "--replay") {
+        return System::replayTrace(argv[2]);
+    }
     System::run();
     return 0;
 }
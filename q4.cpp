@@ -10,91 +10,14 @@ Design the classes and implement.
 
 #include <iostream>
 #include <string>
-using namespace std;
-
-class Cricketer {
-protected:
-    string name;
-    string date_of_birth;
-    int matches_played;
-
-public:
-    Cricketer(string name, string date_of_birth, int matches_played)
-        : name(name), date_of_birth(date_of_birth), matches_played(matches_played) {}
-
-    virtual void show_details() const {
-        cout << "Name: " << name << endl;
-        cout << "Date of Birth: " << date_of_birth << endl;
-        cout << "Matches Played: " << matches_played << endl;
-    }
-
-    virtual ~Cricketer() {}
-};
+#include <vector>
+#include <string_view>
 
-class Bowler : virtual public Cricketer {
-protected:
-    int wickets_taken;
-    double average_economy;
-
-public:
-    Bowler(string name, string date_of_birth, int matches_played, int wickets_taken, double average_economy)
-        : Cricketer(name, date_of_birth, matches_played), wickets_taken(wickets_taken), average_economy(average_economy) {}
-
-    void show_details() const override {
-        Cricketer::show_details();
-        cout << "Wickets Taken: " << wickets_taken << endl;
-        cout << "Average Economy: " << average_economy << endl;
-    }
-};
-
-class Batsman : virtual public Cricketer {
-protected:
-    int total_runs;
-    double average_score;
-
-public:
-    Batsman(string name, string date_of_birth, int matches_played, int total_runs, double average_score)
-        : Cricketer(name, date_of_birth, matches_played), total_runs(total_runs), average_score(average_score) {}
-
-    void show_details() const override {
-        Cricketer::show_details();
-        cout << "Total Runs: " << total_runs << endl;
-        cout << "Average Score: " << average_score << endl;
-    }
-};
+#include "cricket/cricket.h"
+#include "replay/replay.h"
 
-class AllRounder : public Bowler, public Batsman {
-public:
-    AllRounder(string name, string date_of_birth, int matches_played, int wickets_taken, double average_economy,
-               int total_runs, double average_score)
-        : Cricketer(name, date_of_birth, matches_played), Bowler(name, date_of_birth, matches_played, wickets_taken, average_economy),
-          Batsman(name, date_of_birth, matches_played, total_runs, average_score) {}
-
-    void show_details() const override {
-        Cricketer::show_details();
-        cout << "Wickets Taken: " << Bowler::wickets_taken << endl;
-        cout << "Average Economy: " << Bowler::average_economy << endl;
-        cout << "Total Runs: " << Batsman::total_runs << endl;
-        cout << "Average Score: " << Batsman::average_score << endl;
-    }
-};
-
-class DoubleWicketPair {
-private:
-    Bowler* bowler;
-    Batsman* batsman;
-
-public:
-    DoubleWicketPair(Bowler* bowler, Batsman* batsman) : bowler(bowler), batsman(batsman) {}
-
-    void show_details() const {
-        cout << "Double Wicket Pair: " << endl;
-        cout << "Bowler Details:" << endl;
-        bowler->show_details();
-        cout << "Batsman Details:" << endl;
-        batsman->show_details();
-    }
-};
+using namespace std;
+using namespace cricket;
 
 class System {
 private:
@@ -102,9 +25,89 @@ private:
     Batsman* batsman;
     AllRounder* allRounder;
     DoubleWicketPair* doubleWicketPair;
+    BirthDateIndex birth_date_index;
 
 public:
     System() : bowler(nullptr), batsman(nullptr), allRounder(nullptr), doubleWicketPair(nullptr) {}
+    ~System() {
+        set_pair(nullptr);
+        delete bowler;
+        delete batsman;
+        delete allRounder;
+    }
+
+    System(const System&) = delete;
+    System& operator=(const System&) = delete;
+
+    // Headless counterpart of show_menu(): executes a command trace with no
+    // prompts. Commands:
+    //   bowler <name> <dob> <matches> <wickets> <economy>
+    //   batsman <name> <dob> <matches> <runs> <average>
+    //   allrounder <name> <dob> <matches> <wickets> <economy> <runs> <average>
+    //   pair, match <role> <runs> <wickets> <economy>, form <role> <window>,
+    //   born <from> <to>, aged <on> <min_age> <max_age>
+    // where role is bowler, batsman or allrounder.
+    int replay_trace(const char* path) {
+        vector<double> curve;
+        return replay::run(path, [&](const replay::Command& command) {
+            if (command.op == "match") {
+                replay::expectArgs(command, 4);
+                Cricketer* cricketer = cricketer_for(replay::viewArg(command, 0));
+                if (!cricketer) return false;
+                cricketer->record_match(replay::intArg(command, 1), replay::intArg(command, 2), replay::doubleArg(command, 3));
+                return true;
+            }
+            if (command.op == "form") {
+                replay::expectArgs(command, 2);
+                Cricketer* cricketer = cricketer_for(replay::viewArg(command, 0));
+                int window = replay::intArg(command, 1);
+                if (!cricketer || window <= 0) return false;
+                const SeasonHistory& history = cricketer->get_history();
+                history.recent_average_score(window);
+                history.recent_wickets(window);
+                history.recent_economy(window);
+                history.average_score_curve(window, curve);
+                return true;
+            }
+            if (command.op == "born") {
+                replay::expectArgs(command, 2);
+                Date from, to;
+                if (!Date::parse(replay::stringArg(command, 0), from) || !Date::parse(replay::stringArg(command, 1), to)) return false;
+                birth_date_index.born_between(from, to);
+                return true;
+            }
+            if (command.op == "aged") {
+                replay::expectArgs(command, 3);
+                Date on;
+                if (!Date::parse(replay::stringArg(command, 0), on)) return false;
+                birth_date_index.aged_between(on, replay::intArg(command, 1), replay::intArg(command, 2));
+                return true;
+            }
+            if (command.op == "bowler" || command.op == "batsman" || command.op == "allrounder") {
+                replay::expectArgs(command, command.op == "allrounder" ? 7 : 5);
+                string name = replay::stringArg(command, 0);
+                Date date_of_birth;
+                if (!Date::parse(replay::stringArg(command, 1), date_of_birth)) return false;
+                int matches_played = replay::intArg(command, 2);
+                if (command.op == "bowler") {
+                    set_player(bowler, new Bowler(name, date_of_birth, matches_played, replay::intArg(command, 3), replay::doubleArg(command, 4)));
+                } else if (command.op == "batsman") {
+                    set_player(batsman, new Batsman(name, date_of_birth, matches_played, replay::intArg(command, 3), replay::doubleArg(command, 4)));
+                } else {
+                    set_player(allRounder, new AllRounder(name, date_of_birth, matches_played, replay::intArg(command, 3), replay::doubleArg(command, 4),
+                                                          replay::intArg(command, 5), replay::doubleArg(command, 6)));
+                }
+                return true;
+            }
+            if (command.op == "pair") {
+                replay::expectArgs(command, 0);
+                if (!bowler || !batsman) return false;
+                set_pair(new DoubleWicketPair(bowler, batsman));
+                return true;
+            }
+            replay::unknownCommand(command);
+        });
+    }
 
     void show_menu() {
         int choice;
@@ -118,7 +121,11 @@ public:
             cout << "6. Show Batsman Details\n";
             cout << "7. Show All-rounder Details\n";
             cout << "8. Show Double Wicket Pair Details\n";
-            cout << "9. Exit\n";
+            cout << "9. Record Match\n";
+            cout << "10. Show Form\n";
+            cout << "11. Show Players Born Between\n";
+            cout << "12. Show Players by Age Bracket\n";
+            cout << "13. Exit\n";
             cout << "Enter your choice: ";
             cin >> choice;
 
@@ -131,57 +138,101 @@ public:
                 case 6: show_batsman_details(); break;
                 case 7: show_allrounder_details(); break;
                 case 8: show_double_wicket_pair_details(); break;
-                case 9: cout << "Exiting...\n"; break;
+                case 9: record_match(); break;
+                case 10: show_form(); break;
+                case 11: show_players_born_between(); break;
+                case 12: show_players_by_age_bracket(); break;
+                case 13: cout << "Exiting...\n"; break;
                 default: cout << "Invalid choice. Please try again.\n";
             }
-        } while (choice != 9);
+        } while (choice != 13);
     }
 
 private:
+    // System owns the players in its slots and the pair. A replaced player is
+    // deleted once neither a slot nor the pair refers to it.
+    void retire(Cricketer* player) {
+        if (doubleWicketPair && (doubleWicketPair->get_bowler() == player || doubleWicketPair->get_batsman() == player)) return;
+        delete player;
+    }
+
+    // Points the slot at a new player and keeps the birth-date index in step,
+    // dropping the player being replaced.
+    template <typename T>
+    void set_player(T*& slot, T* player) {
+        T* replaced = slot;
+        if (replaced) birth_date_index.remove(replaced);
+        slot = player;
+        birth_date_index.add(player);
+        if (replaced) retire(replaced);
+    }
+
+    void set_pair(DoubleWicketPair* pair) {
+        DoubleWicketPair* replaced = doubleWicketPair;
+        doubleWicketPair = pair;
+        if (!replaced) return;
+        if (replaced->get_bowler() != bowler) retire(replaced->get_bowler());
+        if (replaced->get_batsman() != batsman) retire(replaced->get_batsman());
+        delete replaced;
+    }
+
+    static bool read_date(Date& date) {
+        string text;
+        cin >> text;
+        if (!Date::parse(text, date)) {
+            cout << "Invalid date. Expected YYYY-MM-DD.\n";
+            return false;
+        }
+        return true;
+    }
+
     void add_bowler() {
-        string name, date_of_birth;
+        string name;
+        Date date_of_birth;
         int matches_played, wickets_taken;
         double average_economy;
         cout << "Enter Bowler's Name: ";
         cin >> name;
         cout << "Enter Bowler's Date of Birth (YYYY-MM-DD): ";
-        cin >> date_of_birth;
+        if (!read_date(date_of_birth)) return;
         cout << "Enter Matches Played: ";
         cin >> matches_played;
         cout << "Enter Wickets Taken: ";
         cin >> wickets_taken;
         cout << "Enter Average Economy: ";
         cin >> average_economy;
-        bowler = new Bowler(name, date_of_birth, matches_played, wickets_taken, average_economy);
+        set_player(bowler, new Bowler(name, date_of_birth, matches_played, wickets_taken, average_economy));
         cout << "Bowler added successfully.\n";
     }
 
     void add_batsman() {
-        string name, date_of_birth;
+        string name;
+        Date date_of_birth;
         int matches_played, total_runs;
         double average_score;
         cout << "Enter Batsman's Name: ";
         cin >> name;
         cout << "Enter Batsman's Date of Birth (YYYY-MM-DD): ";
-        cin >> date_of_birth;
+        if (!read_date(date_of_birth)) return;
         cout << "Enter Matches Played: ";
         cin >> matches_played;
         cout << "Enter Total Runs: ";
         cin >> total_runs;
         cout << "Enter Average Score: ";
         cin >> average_score;
-        batsman = new Batsman(name, date_of_birth, matches_played, total_runs, average_score);
+        set_player(batsman, new Batsman(name, date_of_birth, matches_played, total_runs, average_score));
         cout << "Batsman added successfully.\n";
     }
 
     void add_allrounder() {
-        string name, date_of_birth;
+        string name;
+        Date date_of_birth;
         int matches_played, wickets_taken, total_runs;
         double average_economy, average_score;
         cout << "Enter All-rounder's Name: ";
         cin >> name;
         cout << "Enter All-rounder's Date of Birth (YYYY-MM-DD): ";
-        cin >> date_of_birth;
+        if (!read_date(date_of_birth)) return;
         cout << "Enter Matches Played: ";
         cin >> matches_played;
         cout << "Enter Wickets Taken: ";
@@ -192,13 +243,13 @@ private:
         cin >> total_runs;
         cout << "Enter Average Score: ";
         cin >> average_score;
-        allRounder = new AllRounder(name, date_of_birth, matches_played, wickets_taken, average_economy, total_runs, average_score);
+        set_player(allRounder, new AllRounder(name, date_of_birth, matches_played, wickets_taken, average_economy, total_runs, average_score));
         cout << "All-rounder added successfully.\n";
     }
 
     void create_double_wicket_pair() {
         if (bowler && batsman) {
-            doubleWicketPair = new DoubleWicketPair(bowler, batsman);
+            set_pair(new DoubleWicketPair(bowler, batsman));
             cout << "Double Wicket Pair created successfully.\n";
         } else {
             cout << "Bowler and Batsman must be added first.\n";
@@ -236,4 +287,103 @@ private:
             cout << "No double wicket pair found.\n";
         }
     }
-};
\ No newline at end of file
+
+    static void list_players(const vector<Cricketer*>& players) {
+        if (players.empty()) {
+            cout << "No players found.\n";
+            return;
+        }
+        for (size_t i = 0; i < players.size(); ++i) {
+            cout << players[i]->get_name() << " (" << players[i]->get_date_of_birth().to_string() << ")\n";
+        }
+    }
+
+    void show_players_born_between() const {
+        Date from, to;
+        cout << "Enter From Date (YYYY-MM-DD): ";
+        if (!read_date(from)) return;
+        cout << "Enter To Date (YYYY-MM-DD): ";
+        if (!read_date(to)) return;
+        list_players(birth_date_index.born_between(from, to));
+    }
+
+    void show_players_by_age_bracket() const {
+        Date on;
+        int min_age, max_age;
+        cout << "Enter Reference Date (YYYY-MM-DD): ";
+        if (!read_date(on)) return;
+        cout << "Enter Minimum Age: ";
+        cin >> min_age;
+        cout << "Enter Maximum Age: ";
+        cin >> max_age;
+        list_players(birth_date_index.aged_between(on, min_age, max_age));
+    }
+
+    Cricketer* cricketer_for(string_view role) const {
+        if (role == "bowler") return bowler;
+        if (role == "batsman") return batsman;
+        if (role == "allrounder") return allRounder;
+        return nullptr;
+    }
+
+    Cricketer* select_cricketer() const {
+        int type;
+        cout << "Select Cricketer (1. Bowler, 2. Batsman, 3. All-rounder): ";
+        cin >> type;
+        Cricketer* cricketer = nullptr;
+        switch (type) {
+            case 1: cricketer = bowler; break;
+            case 2: cricketer = batsman; break;
+            case 3: cricketer = allRounder; break;
+            default: cout << "Invalid choice.\n"; return nullptr;
+        }
+        if (!cricketer) cout << "No such cricketer found.\n";
+        return cricketer;
+    }
+
+    void record_match() {
+        Cricketer* cricketer = select_cricketer();
+        if (!cricketer) return;
+        int runs, wickets;
+        double economy;
+        cout << "Enter Runs Scored: ";
+        cin >> runs;
+        cout << "Enter Wickets Taken: ";
+        cin >> wickets;
+        cout << "Enter Economy: ";
+        cin >> economy;
+        cricketer->record_match(runs, wickets, economy);
+        cout << "Match recorded successfully.\n";
+    }
+
+    void show_form() const {
+        Cricketer* cricketer = select_cricketer();
+        if (!cricketer) return;
+        int window;
+        cout << "Enter Window (matches): ";
+        cin >> window;
+        if (window <= 0) {
+            cout << "Window must be positive.\n";
+            return;
+        }
+        const SeasonHistory& history = cricketer->get_history();
+        cout << "Matches Recorded: " << history.matches() << endl;
+        cout << "Average Score (last " << window << "): " << history.recent_average_score(window) << endl;
+        cout << "Wickets per Match (last " << window << "): " << history.recent_wickets(window) << endl;
+        cout << "Economy (last " << window << "): " << history.recent_economy(window) << endl;
+        vector<double> curve;
+        history.average_score_curve(window, curve);
+        cout << "Average Score Curve:";
+        for (size_t i = 0; i < curve.size(); ++i) cout << " " << curve[i];
+        cout << endl;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    System system;
+    if (argc == 3 && string(argv[1]) == "--replay") {
+        return system.replay_trace(argv[2]);
+    }
+    system.show_menu();
+    return 0;
+}
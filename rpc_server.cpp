@@ -0,0 +1,99 @@
+/*
+Serves the library circulation and enrollment engines to local clients over
+the binary protocol in src/rpc/protocol.h.
+
+    rpc_server (--unix <path> | --port <n>) [--workers <n>] [--populate]
+
+--populate preloads the synthetic registry used by rpc_loadgen.
+*/
+#include <cerrno>
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "rpc/server.h"
+#include "datagen.h"
+
+namespace {
+
+rpc::Server* activeServer = nullptr;
+
+void handleSignal(int) {
+    if (activeServer) activeServer->stop();
+}
+
+// Whole-string decimal parse; false for anything else or a value below min.
+bool parseInt(const char* text, int min, int& value) {
+    char* end;
+    errno = 0;
+    long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || errno != 0 || parsed < min || parsed > INT_MAX) return false;
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string unixPath;
+    int port = -1;
+    bool populate = false;
+    rpc::ServerOptions options;
+    options.workers = static_cast<int>(std::thread::hardware_concurrency());
+    if (options.workers < 1) options.workers = 1;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--unix" && i + 1 < argc) {
+            unixPath = argv[++i];
+        } else if (arg == "--port" && i + 1 < argc) {
+            if (!parseInt(argv[++i], 0, port) || port > 65535) {
+                std::cerr << "rpc_server: --port needs a number from 0 to 65535\n";
+                return 2;
+            }
+        } else if (arg == "--workers" && i + 1 < argc) {
+            if (!parseInt(argv[++i], 1, options.workers)) {
+                std::cerr << "rpc_server: --workers needs a whole number of at least 1\n";
+                return 2;
+            }
+        } else if (arg == "--populate") {
+            populate = true;
+        } else {
+            std::cerr << "usage: " << argv[0] << " (--unix <path> | --port <n>) [--workers <n>] [--populate]\n";
+            return 2;
+        }
+    }
+    if (unixPath.empty() && port < 0) {
+        std::cerr << "rpc_server: one of --unix or --port is required\n";
+        return 2;
+    }
+
+    circulation::Library library;
+    enrollment::StudentList studentList;
+    enrollment::SubjectList subjectList(studentList.getDomain());
+    if (populate) datagen::populateServerFixture(library, studentList, subjectList);
+
+    rpc::Server server(library, studentList, subjectList, options);
+    std::string error;
+    bool listening = unixPath.empty() ? server.listenTcp(port, error) : server.listenUnix(unixPath, error);
+    if (!listening) {
+        std::cerr << "rpc_server: " << error << "\n";
+        return 1;
+    }
+    if (unixPath.empty()) {
+        std::cout << "Listening on 127.0.0.1:" << server.getPort() << std::endl;
+    } else {
+        std::cout << "Listening on " << unixPath << std::endl;
+    }
+
+    activeServer = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+    server.run();
+    activeServer = nullptr;
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include "circulation/library.h"
+
+#include "instrument/instrument.h"
+
+namespace circulation {
+
+const char* describe(Status status) {
+    switch (status) {
+        case Status::Ok: return "Success.";
+        case Status::DuplicateBook: return "Error: Book with this ID and serial number already exists.";
+        case Status::DuplicateMember: return "Error: Member with this ID already exists.";
+        case Status::InvalidMember: return "Error: Invalid member ID.";
+        case Status::BookNotFound: return "Error: Book ID not found.";
+        case Status::CopyNotFound: return "Error: Book ID or serial number not found.";
+        case Status::LimitReached: return "Error: Member has reached the maximum limit of issued books.";
+        case Status::NoCopyAvailable: return "Error: No available copy of the book.";
+        case Status::NotIssuedToMember: return "Error: This book was not issued to this member.";
+    }
+    return "Error: Unknown status.";
+}
+
+Library::~Library() {
+    for (auto& bookMap : books) {
+        for (auto& book : bookMap.second) {
+            delete book.second;
+        }
+    }
+    for (auto& member : members) {
+        delete member.second;
+    }
+    transactionLog.forEach([](Transaction* transaction) { delete transaction; });
+}
+
+Status Library::addBook(const std::string& bookId, int serialNumber, const std::string& title, const std::string& author, const std::string& publisher, double price) {
+    INSTRUMENT_SCOPE("circulation.addBook");
+    std::map<int, Book*>& copies = books[bookId];
+    if (copies.find(serialNumber) != copies.end()) {
+        return Status::DuplicateBook;
+    }
+    mvcc::Write write(domain);
+    Book* book = new Book(bookId, serialNumber, title, author, publisher, price);
+    copies[serialNumber] = book;
+    bookLog.append(write, book);
+    write.commit();
+    return Status::Ok;
+}
+
+Status Library::addMember(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address, bool isFaculty) {
+    INSTRUMENT_SCOPE("circulation.addMember");
+    if (members.find(memberId) != members.end()) {
+        return Status::DuplicateMember;
+    }
+    Member* member = nullptr;
+    if (isFaculty) {
+        member = new Faculty(memberId, name, email, address);
+    } else {
+        member = new Student(memberId, name, email, address);
+    }
+    mvcc::Write write(domain);
+    members[memberId] = member;
+    memberLog.append(write, member);
+    write.commit();
+    return Status::Ok;
+}
+
+Status Library::issueBook(const std::string& memberId, const std::string& bookId, int* issuedSerial) {
+    INSTRUMENT_SCOPE("circulation.issueBook");
+    std::map<std::string, Member*>::iterator memberIt = members.find(memberId);
+    if (memberIt == members.end()) {
+        return Status::InvalidMember;
+    }
+    std::map<std::string, std::map<int, Book*>>::iterator bookIt = books.find(bookId);
+    if (bookIt == books.end()) {
+        return Status::BookNotFound;
+    }
+    Member* member = memberIt->second;
+    if (!member->canIssueMoreBooks()) {
+        return Status::LimitReached;
+    }
+    for (auto& bookPair : bookIt->second) {
+        Book* book = bookPair.second;
+        if (book->checkAvailability()) {
+            mvcc::Write write(domain);
+            book->markIssued(write);
+            member->issueBook(write);
+            Transaction* transaction = new Transaction(memberId, bookId, book->getSerialNumber());
+            transactionLog.append(write, transaction);
+            write.commit();
+            if (issuedSerial) {
+                *issuedSerial = book->getSerialNumber();
+            }
+            return Status::Ok;
+        }
+    }
+    return Status::NoCopyAvailable;
+}
+
+Status Library::returnBook(const std::string& memberId, const std::string& bookId, int serialNumber) {
+    INSTRUMENT_SCOPE("circulation.returnBook");
+    std::map<std::string, Member*>::iterator memberIt = members.find(memberId);
+    if (memberIt == members.end()) {
+        return Status::InvalidMember;
+    }
+    std::map<std::string, std::map<int, Book*>>::iterator bookIt = books.find(bookId);
+    if (bookIt == books.end()) {
+        return Status::CopyNotFound;
+    }
+    std::map<int, Book*>::iterator copyIt = bookIt->second.find(serialNumber);
+    if (copyIt == bookIt->second.end()) {
+        return Status::CopyNotFound;
+    }
+    Transaction* transaction = transactionLog.findFirst([&](const Transaction* candidate) {
+        return candidate->checkTransaction(memberId, bookId, serialNumber);
+    });
+    if (!transaction) {
+        return Status::NotIssuedToMember;
+    }
+    mvcc::Write write(domain);
+    transaction->markReturned(write);
+    copyIt->second->markReturned(write);
+    memberIt->second->returnBook(write);
+    write.commit();
+    return Status::Ok;
+}
+
+Totals Library::totals(const mvcc::Snapshot& snapshot) const {
+    INSTRUMENT_SCOPE("circulation.totals");
+    Totals totals;
+    bookLog.forEach(snapshot, [&](const Book* book) {
+        ++totals.copies;
+        if (!book->checkAvailability(snapshot)) ++totals.issuedCopies;
+    });
+    memberLog.forEach(snapshot, [&](const Member* member) {
+        ++totals.members;
+        totals.loansHeld += member->getBooksIssued(snapshot);
+    });
+    transactionLog.forEach(snapshot, [&](const Transaction* transaction) {
+        ++totals.transactions;
+        if (!transaction->checkReturned(snapshot)) ++totals.openTransactions;
+    });
+    return totals;
+}
+
+void Library::report(const mvcc::Snapshot& snapshot, std::ostream& os) const {
+    INSTRUMENT_SCOPE("circulation.report");
+    os << "Books:\n";
+    bookLog.forEach(snapshot, [&](const Book* book) {
+        os << "  " << book->getBookId() << " #" << book->getSerialNumber() << ": "
+           << (book->checkAvailability(snapshot) ? "available" : "issued") << "\n";
+    });
+    os << "Members:\n";
+    memberLog.forEach(snapshot, [&](const Member* member) {
+        os << "  " << member->getMemberId() << ": " << member->getBooksIssued(snapshot) << "/" << member->getMaxBooks() << " issued\n";
+    });
+    Totals counts = totals(snapshot);
+    os << "Copies: " << counts.copies << " (" << counts.issuedCopies << " issued), members: " << counts.members
+       << ", transactions: " << counts.transactions << " (" << counts.openTransactions << " open)\n";
+}
+
+}  // namespace circulation
@@ -0,0 +1,177 @@
+/*
+Library circulation engine: book copies keyed by book-id and serial number,
+student/faculty members with their issue limits, and the transaction log of
+issues and returns. Operations report their outcome as a Status so callers
+decide how to present it.
+
+Loan state (copy availability, member loan counts, returned flags) is kept in
+mvcc::Versioned cells and every book, member and transaction is recorded in
+an mvcc::AppendLog, so report() can read a consistent snapshot while issues
+and returns continue. The transaction log is the only record of transactions;
+the engine itself reads its latest view.
+*/
+#ifndef CIRCULATION_LIBRARY_H
+#define CIRCULATION_LIBRARY_H
+
+#include <map>
+#include <string>
+#include <ctime>
+#include <ostream>
+
+#include "mvcc/mvcc.h"
+
+namespace circulation {
+
+enum class Status {
+    Ok,
+    DuplicateBook,
+    DuplicateMember,
+    InvalidMember,
+    BookNotFound,
+    CopyNotFound,
+    LimitReached,
+    NoCopyAvailable,
+    NotIssuedToMember
+};
+
+// Message shown to the user for a given outcome.
+const char* describe(Status status);
+
+// Counts read from one snapshot. In a consistent view issuedCopies,
+// openTransactions and loansHeld are always equal.
+struct Totals {
+    size_t copies = 0;
+    size_t issuedCopies = 0;
+    size_t members = 0;
+    size_t loansHeld = 0;
+    size_t transactions = 0;
+    size_t openTransactions = 0;
+};
+
+class Member {
+protected:
+    std::string memberId;
+    std::string name;
+    std::string email;
+    std::string address;
+    mvcc::Versioned<int> booksIssued;
+
+public:
+    Member(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address)
+        : memberId(memberId), name(name), email(email), address(address), booksIssued(0) {}
+
+    virtual int getMaxBooks() const = 0;
+    std::string getMemberId() const { return memberId; }
+
+    bool canIssueMoreBooks() const { return booksIssued.latest() < getMaxBooks(); }
+    int getBooksIssued(const mvcc::Snapshot& snapshot) const { return booksIssued.get(snapshot); }
+
+    void issueBook(const mvcc::Write& write) { booksIssued.set(write, booksIssued.latest() + 1); }
+    void returnBook(const mvcc::Write& write) { booksIssued.set(write, booksIssued.latest() - 1); }
+
+    virtual ~Member() {}
+};
+
+class Student : public Member {
+public:
+    Student(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address)
+        : Member(memberId, name, email, address) {}
+
+    int getMaxBooks() const override {
+        return 2;
+    }
+};
+
+class Faculty : public Member {
+public:
+    Faculty(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address)
+        : Member(memberId, name, email, address) {}
+
+    int getMaxBooks() const override {
+        return 10;
+    }
+};
+
+class Book {
+private:
+    std::string bookId;
+    int serialNumber;
+    std::string title;
+    std::string author;
+    std::string publisher;
+    double price;
+    mvcc::Versioned<bool> isIssued;
+
+public:
+    Book(const std::string& bookId, int serialNumber, const std::string& title, const std::string& author, const std::string& publisher, double price)
+        : bookId(bookId), serialNumber(serialNumber), title(title), author(author), publisher(publisher), price(price), isIssued(false) {}
+
+    std::string getBookId() const { return bookId; }
+    int getSerialNumber() const { return serialNumber; }
+
+    bool checkAvailability() const { return !isIssued.latest(); }
+    bool checkAvailability(const mvcc::Snapshot& snapshot) const { return !isIssued.get(snapshot); }
+    void markIssued(const mvcc::Write& write) { isIssued.set(write, true); }
+    void markReturned(const mvcc::Write& write) { isIssued.set(write, false); }
+};
+
+class Transaction {
+private:
+    std::string memberId;
+    std::string bookId;
+    int serialNumber;
+    std::time_t date;
+    mvcc::Versioned<bool> isReturned;
+
+public:
+    Transaction(const std::string& memberId, const std::string& bookId, int serialNumber)
+        : memberId(memberId), bookId(bookId), serialNumber(serialNumber), date(std::time(0)), isReturned(false) {}
+
+    void markReturned(const mvcc::Write& write) { isReturned.set(write, true); }
+    bool checkTransaction(const std::string& memId, const std::string& bId, int serNum) const {
+        return memberId == memId && bookId == bId && serialNumber == serNum && !isReturned.latest();
+    }
+    bool checkReturned(const mvcc::Snapshot& snapshot) const { return isReturned.get(snapshot); }
+};
+
+class Library {
+private:
+    std::map<std::string, std::map<int, Book*>> books;
+    std::map<std::string, Member*> members;
+
+    mutable mvcc::Domain domain;
+    mvcc::AppendLog<Book*> bookLog;
+    mvcc::AppendLog<Member*> memberLog;
+    mvcc::AppendLog<Transaction*> transactionLog;
+
+public:
+    Library() {}
+    ~Library();
+
+    Library(const Library&) = delete;
+    Library& operator=(const Library&) = delete;
+
+    Status addBook(const std::string& bookId, int serialNumber, const std::string& title, const std::string& author, const std::string& publisher, double price);
+    Status addMember(const std::string& memberId, const std::string& name, const std::string& email, const std::string& address, bool isFaculty);
+
+    // Issues the first available copy; its serial number is stored in
+    // issuedSerial when one is supplied.
+    Status issueBook(const std::string& memberId, const std::string& bookId, int* issuedSerial = nullptr);
+    Status returnBook(const std::string& memberId, const std::string& bookId, int serialNumber);
+
+    size_t getTransactionCount() const { return transactionLog.size(); }
+
+    // Pass to mvcc::Snapshot to pin a view for report().
+    mvcc::Domain& getDomain() const { return domain; }
+
+    Totals totals(const mvcc::Snapshot& snapshot) const;
+
+    // Circulation report as of the snapshot: every copy with its
+    // availability, every member with their loan count, and the totals.
+    // Takes no lock; safe to run while other threads mutate.
+    void report(const mvcc::Snapshot& snapshot, std::ostream& os) const;
+};
+
+}  // namespace circulation
+
+#endif
@@ -0,0 +1,365 @@
+#include "cricket/cricket.h"
+
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+#include "instrument/instrument.h"
+
+using namespace std;
+
+namespace cricket {
+
+namespace {
+
+bool is_leap(int year) { return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0; }
+
+int days_in_month(int year, int month) {
+    static const int lengths[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && is_leap(year) ? 29 : lengths[month - 1];
+}
+
+int32_t days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void to_civil(int32_t days, int& year, int& month, int& day) {
+    int z = days + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = yoe + era * 400 + (month <= 2);
+}
+
+}  // namespace
+
+bool Date::parse(const string& text, Date& out) {
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return false;
+    int fields[3] = {0, 0, 0};
+    const int starts[3] = {0, 5, 8};
+    const int lengths[3] = {4, 2, 2};
+    for (int f = 0; f < 3; ++f) {
+        for (int i = starts[f]; i < starts[f] + lengths[f]; ++i) {
+            if (text[i] < '0' || text[i] > '9') return false;
+            fields[f] = fields[f] * 10 + (text[i] - '0');
+        }
+    }
+    int year = fields[0], month = fields[1], day = fields[2];
+    if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month)) return false;
+    out = Date(days_from_civil(year, month, day));
+    return true;
+}
+
+Date Date::years_before(int years) const {
+    int year, month, day;
+    to_civil(days, year, month, day);
+    year -= years;
+    if (day > days_in_month(year, month)) day = days_in_month(year, month);
+    return Date(days_from_civil(year, month, day));
+}
+
+string Date::to_string() const {
+    int year, month, day;
+    to_civil(days, year, month, day);
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+void DeltaVarintColumn::append(int64_t value) {
+    int64_t delta = value - last;
+    uint64_t zigzag = (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+    while (zigzag >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(zigzag | 0x80));
+        zigzag >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(zigzag));
+    last = value;
+    ++count;
+}
+
+template <typename Visit>
+void DeltaVarintColumn::visit(Visit visit) const {
+    int64_t value = 0;
+    size_t pos = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t zigzag = 0;
+        int shift = 0;
+        uint8_t byte;
+        do {
+            byte = bytes[pos++];
+            zigzag |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        value += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        visit(i, value);
+    }
+}
+
+void DeltaVarintColumn::decode(vector<double>& out) const {
+    out.resize(count);
+    visit([&](size_t i, int64_t value) { out[i] = static_cast<double>(value); });
+}
+
+double DeltaVarintColumn::sum_from(size_t begin) const {
+    // Integer accumulation is exact, unlike summing the doubles.
+    int64_t sum = 0;
+    visit([&](size_t i, int64_t value) {
+        if (i >= begin) sum += value;
+    });
+    return static_cast<double>(sum);
+}
+
+void GorillaColumn::write_bits(uint64_t value, int n) {
+    while (n > 0) {
+        size_t offset = bit_count % 64;
+        if (offset == 0) words.push_back(0);
+        int room = 64 - static_cast<int>(offset);
+        int take = n < room ? n : room;
+        uint64_t chunk = (take == n ? value : value >> (n - take)) & (take == 64 ? ~0ULL : (1ULL << take) - 1);
+        words.back() |= chunk << (room - take);
+        bit_count += take;
+        n -= take;
+    }
+}
+
+uint64_t GorillaColumn::read_bits(size_t& pos, int n) const {
+    uint64_t value = 0;
+    while (n > 0) {
+        size_t offset = pos % 64;
+        int room = 64 - static_cast<int>(offset);
+        int take = n < room ? n : room;
+        uint64_t chunk = (words[pos / 64] >> (room - take)) & (take == 64 ? ~0ULL : (1ULL << take) - 1);
+        value = take == 64 ? chunk : (value << take) | chunk;
+        pos += take;
+        n -= take;
+    }
+    return value;
+}
+
+void GorillaColumn::append(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    if (count++ == 0) {
+        write_bits(bits, 64);
+        prev_bits = bits;
+        return;
+    }
+    uint64_t x = bits ^ prev_bits;
+    prev_bits = bits;
+    if (x == 0) {
+        write_bits(0, 1);
+        return;
+    }
+    int leading = __builtin_clzll(x);
+    int trailing = __builtin_ctzll(x);
+    if (leading > 31) leading = 31;
+    if (prev_leading >= 0 && leading >= prev_leading && trailing >= prev_trailing) {
+        write_bits(0b10, 2);
+        write_bits(x >> prev_trailing, 64 - prev_leading - prev_trailing);
+    } else {
+        int meaningful = 64 - leading - trailing;
+        write_bits(0b11, 2);
+        write_bits(leading, 5);
+        write_bits(meaningful & 63, 6);
+        write_bits(x >> trailing, meaningful);
+        prev_leading = leading;
+        prev_trailing = trailing;
+    }
+}
+
+template <typename Visit>
+void GorillaColumn::visit(Visit visit) const {
+    size_t pos = 0;
+    uint64_t bits = 0;
+    int leading = 0, trailing = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (i == 0) {
+            bits = read_bits(pos, 64);
+        } else if (read_bits(pos, 1) == 1) {
+            if (read_bits(pos, 1) == 1) {
+                leading = static_cast<int>(read_bits(pos, 5));
+                int meaningful = static_cast<int>(read_bits(pos, 6));
+                if (meaningful == 0) meaningful = 64;
+                trailing = 64 - leading - meaningful;
+            }
+            bits ^= read_bits(pos, 64 - leading - trailing) << trailing;
+        }
+        double value;
+        memcpy(&value, &bits, sizeof(bits));
+        visit(i, value);
+    }
+}
+
+void GorillaColumn::decode(vector<double>& out) const {
+    out.resize(count);
+    visit([&](size_t i, double value) { out[i] = value; });
+}
+
+double GorillaColumn::sum_from(size_t begin) const {
+    double sum = 0.0;
+    visit([&](size_t i, double value) {
+        if (i >= begin) sum += value;
+    });
+    return sum;
+}
+
+namespace {
+
+// Replaces values with the moving average over the trailing window ending at
+// each match. values becomes its own prefix sums, then is rewritten from the
+// back so the prefix each window subtracts has not been overwritten yet.
+void rolling_mean(vector<double>& values, size_t window) {
+    size_t n = values.size();
+    for (size_t i = 1; i < n; ++i) values[i] += values[i - 1];
+    for (size_t i = n; i-- > 0;) {
+        size_t begin = i + 1 > window ? i + 1 - window : 0;
+        double before = begin > 0 ? values[begin - 1] : 0.0;
+        values[i] = (values[i] - before) / static_cast<double>(i + 1 - begin);
+    }
+}
+
+// Mean of the last window values of a column, without decoding it to a buffer.
+template <typename Column>
+double tail_mean(const Column& column, size_t window) {
+    size_t n = column.size();
+    size_t begin = n > window ? n - window : 0;
+    if (n == begin) return 0.0;
+    return column.sum_from(begin) / static_cast<double>(n - begin);
+}
+
+}  // namespace
+
+double SeasonHistory::recent_average_score(size_t window) const {
+    INSTRUMENT_SCOPE("cricket.recentAverageScore");
+    return tail_mean(runs, window);
+}
+
+double SeasonHistory::recent_economy(size_t window) const {
+    INSTRUMENT_SCOPE("cricket.recentEconomy");
+    return tail_mean(economy, window);
+}
+
+double SeasonHistory::recent_wickets(size_t window) const {
+    INSTRUMENT_SCOPE("cricket.recentWickets");
+    return tail_mean(wickets, window);
+}
+
+void SeasonHistory::average_score_curve(size_t window, vector<double>& out) const {
+    INSTRUMENT_SCOPE("cricket.averageScoreCurve");
+    runs.decode(out);
+    rolling_mean(out, window);
+}
+
+void SeasonHistory::economy_curve(size_t window, vector<double>& out) const {
+    INSTRUMENT_SCOPE("cricket.economyCurve");
+    economy.decode(out);
+    rolling_mean(out, window);
+}
+
+void Cricketer::show_details() const {
+    cout << "Name: " << name << endl;
+    cout << "Date of Birth: " << date_of_birth.to_string() << endl;
+    cout << "Matches Played: " << matches_played << endl;
+}
+
+void Bowler::show_details() const {
+    Cricketer::show_details();
+    cout << "Wickets Taken: " << wickets_taken << endl;
+    cout << "Average Economy: " << average_economy << endl;
+}
+
+void Batsman::show_details() const {
+    Cricketer::show_details();
+    cout << "Total Runs: " << total_runs << endl;
+    cout << "Average Score: " << average_score << endl;
+}
+
+void AllRounder::show_details() const {
+    Cricketer::show_details();
+    cout << "Wickets Taken: " << Bowler::wickets_taken << endl;
+    cout << "Average Economy: " << Bowler::average_economy << endl;
+    cout << "Total Runs: " << Batsman::total_runs << endl;
+    cout << "Average Score: " << Batsman::average_score << endl;
+}
+
+void DoubleWicketPair::show_details() const {
+    cout << "Double Wicket Pair: " << endl;
+    cout << "Bowler Details:" << endl;
+    bowler->show_details();
+    cout << "Batsman Details:" << endl;
+    batsman->show_details();
+}
+
+void BirthDateIndex::add(Cricketer* cricketer) {
+    pending.push_back(make_pair(cricketer->get_date_of_birth().day_number(), cricketer));
+}
+
+bool BirthDateIndex::remove(const Cricketer* cricketer) {
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].second == cricketer) {
+            pending.erase(pending.begin() + i);
+            return true;
+        }
+    }
+    vector<Cricketer*>::iterator it = find(players.begin(), players.end(), cricketer);
+    if (it == players.end()) return false;
+    birth_days.erase(birth_days.begin() + (it - players.begin()));
+    players.erase(it);
+    return true;
+}
+
+// Sorts the buffered additions and merges them behind any equal birth days
+// already indexed, so players sharing a birthday stay in insertion order.
+void BirthDateIndex::merge_pending() const {
+    if (pending.empty()) return;
+    INSTRUMENT_SCOPE("cricket.indexMerge");
+    stable_sort(pending.begin(), pending.end(),
+                [](const pair<int32_t, Cricketer*>& a, const pair<int32_t, Cricketer*>& b) { return a.first < b.first; });
+    vector<int32_t> merged_days;
+    vector<Cricketer*> merged_players;
+    merged_days.reserve(birth_days.size() + pending.size());
+    merged_players.reserve(birth_days.size() + pending.size());
+    size_t i = 0, j = 0;
+    while (i < birth_days.size() || j < pending.size()) {
+        if (j == pending.size() || (i < birth_days.size() && birth_days[i] <= pending[j].first)) {
+            merged_days.push_back(birth_days[i]);
+            merged_players.push_back(players[i]);
+            ++i;
+        } else {
+            merged_days.push_back(pending[j].first);
+            merged_players.push_back(pending[j].second);
+            ++j;
+        }
+    }
+    birth_days.swap(merged_days);
+    players.swap(merged_players);
+    pending.clear();
+}
+
+vector<Cricketer*> BirthDateIndex::born_between(Date from, Date to) const {
+    INSTRUMENT_SCOPE("cricket.bornBetween");
+    merge_pending();
+    vector<int32_t>::const_iterator first = lower_bound(birth_days.begin(), birth_days.end(), from.day_number());
+    vector<int32_t>::const_iterator last = upper_bound(birth_days.begin(), birth_days.end(), to.day_number());
+    if (first >= last) return vector<Cricketer*>();
+    return vector<Cricketer*>(players.begin() + (first - birth_days.begin()), players.begin() + (last - birth_days.begin()));
+}
+
+vector<Cricketer*> BirthDateIndex::aged_between(Date on, int min_age, int max_age) const {
+    INSTRUMENT_SCOPE("cricket.agedBetween");
+    Date youngest = on.years_before(min_age);
+    Date oldest = on.years_before(max_age + 1).next_day();
+    return born_between(oldest, youngest);
+}
+
+}  // namespace cricket
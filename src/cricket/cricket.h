@@ -0,0 +1,266 @@
+/*
+Cricket registry: cricketers (bowler, batsman, all-rounder) with their career
+totals, a compressed per-match season history for form queries, and a
+birth-date index for age-group selection.
+*/
+#ifndef CRICKET_CRICKET_H
+#define CRICKET_CRICKET_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+namespace cricket {
+
+// Calendar date packed as a day number relative to 1970-01-01. Parsed and
+// validated once from "YYYY-MM-DD" so comparisons are plain integer compares.
+class Date {
+private:
+    int32_t days;
+
+public:
+    Date() : days(0) {}
+    explicit Date(int32_t days) : days(days) {}
+
+    static bool parse(const std::string& text, Date& out);
+
+    // Same calendar day the given number of years earlier; 29 Feb maps to 28 Feb.
+    Date years_before(int years) const;
+
+    Date next_day() const { return Date(days + 1); }
+    int32_t day_number() const { return days; }
+
+    std::string to_string() const;
+};
+
+// Append-only integer column: each value is stored as the zigzag-encoded delta
+// from the previous one, packed as a LEB128 varint.
+class DeltaVarintColumn {
+private:
+    std::vector<uint8_t> bytes;
+    int64_t last;
+    size_t count;
+
+    template <typename Visit>
+    void visit(Visit visit) const;
+
+public:
+    DeltaVarintColumn() : last(0), count(0) {}
+
+    void append(int64_t value);
+    void decode(std::vector<double>& out) const;
+    // Sum of the values from index begin on, decoded without a buffer.
+    double sum_from(size_t begin) const;
+
+    void compact() { bytes.shrink_to_fit(); }
+    size_t size() const { return count; }
+    // Heap buffer only.
+    size_t memory_bytes() const { return bytes.capacity(); }
+};
+
+// Append-only floating point column using Gorilla XOR compression: a value equal
+// to its predecessor costs one bit, and values that differ only in a few mantissa
+// bits reuse the previous leading/trailing zero window.
+class GorillaColumn {
+private:
+    std::vector<uint64_t> words;
+    size_t bit_count;
+    uint64_t prev_bits;
+    int prev_leading;
+    int prev_trailing;
+    size_t count;
+
+    void write_bits(uint64_t value, int n);
+    uint64_t read_bits(size_t& pos, int n) const;
+
+    template <typename Visit>
+    void visit(Visit visit) const;
+
+public:
+    GorillaColumn() : bit_count(0), prev_bits(0), prev_leading(-1), prev_trailing(0), count(0) {}
+
+    void append(double value);
+    void decode(std::vector<double>& out) const;
+    // Sum of the values from index begin on, decoded without a buffer.
+    double sum_from(size_t begin) const;
+
+    void compact() { words.shrink_to_fit(); }
+    size_t size() const { return count; }
+    // Heap buffer only.
+    size_t memory_bytes() const { return words.capacity() * sizeof(uint64_t); }
+};
+
+// Per-match history of a cricketer for a season, kept compressed and only
+// decoded when a form query is made.
+class SeasonHistory {
+private:
+    DeltaVarintColumn runs;
+    DeltaVarintColumn wickets;
+    GorillaColumn economy;
+
+public:
+    void record(int match_runs, int match_wickets, double match_economy) {
+        runs.append(match_runs);
+        wickets.append(match_wickets);
+        economy.append(match_economy);
+    }
+
+    // Releases the slack left by vector growth once a season is closed.
+    void compact() {
+        runs.compact();
+        wickets.compact();
+        economy.compact();
+    }
+
+    size_t matches() const { return runs.size(); }
+
+    // The object itself plus its column buffers. Per-allocation allocator
+    // overhead (three heap blocks) is not included.
+    size_t memory_bytes() const {
+        return sizeof(SeasonHistory) + runs.memory_bytes() + wickets.memory_bytes() + economy.memory_bytes();
+    }
+
+    double recent_average_score(size_t window) const;
+    double recent_economy(size_t window) const;
+    double recent_wickets(size_t window) const;
+
+    // Write the moving average into out, reusing its capacity, so callers
+    // walking many players can keep one buffer.
+    void average_score_curve(size_t window, std::vector<double>& out) const;
+    void economy_curve(size_t window, std::vector<double>& out) const;
+};
+
+class Cricketer {
+protected:
+    std::string name;
+    Date date_of_birth;
+    int matches_played;
+    SeasonHistory history;
+
+public:
+    Cricketer(std::string name, Date date_of_birth, int matches_played)
+        : name(name), date_of_birth(date_of_birth), matches_played(matches_played) {}
+
+    const std::string& get_name() const { return name; }
+    Date get_date_of_birth() const { return date_of_birth; }
+
+    virtual void record_match(int runs, int wickets, double economy) {
+        history.record(runs, wickets, economy);
+        ++matches_played;
+    }
+
+    const SeasonHistory& get_history() const { return history; }
+
+    virtual void show_details() const;
+
+    virtual ~Cricketer() {}
+};
+
+class Bowler : virtual public Cricketer {
+protected:
+    int wickets_taken;
+    double average_economy;
+
+public:
+    Bowler(std::string name, Date date_of_birth, int matches_played, int wickets_taken, double average_economy)
+        : Cricketer(name, date_of_birth, matches_played), wickets_taken(wickets_taken), average_economy(average_economy) {}
+
+    void record_match(int runs, int wickets, double economy) override {
+        Cricketer::record_match(runs, wickets, economy);
+        update_bowling(wickets, economy);
+    }
+
+    void show_details() const override;
+
+protected:
+    void update_bowling(int wickets, double economy) {
+        wickets_taken += wickets;
+        average_economy += (economy - average_economy) / matches_played;
+    }
+};
+
+class Batsman : virtual public Cricketer {
+protected:
+    int total_runs;
+    double average_score;
+
+public:
+    Batsman(std::string name, Date date_of_birth, int matches_played, int total_runs, double average_score)
+        : Cricketer(name, date_of_birth, matches_played), total_runs(total_runs), average_score(average_score) {}
+
+    void record_match(int runs, int wickets, double economy) override {
+        Cricketer::record_match(runs, wickets, economy);
+        update_batting(runs);
+    }
+
+    void show_details() const override;
+
+protected:
+    void update_batting(int runs) {
+        total_runs += runs;
+        average_score = static_cast<double>(total_runs) / matches_played;
+    }
+};
+
+class AllRounder : public Bowler, public Batsman {
+public:
+    AllRounder(std::string name, Date date_of_birth, int matches_played, int wickets_taken, double average_economy,
+               int total_runs, double average_score)
+        : Cricketer(name, date_of_birth, matches_played), Bowler(name, date_of_birth, matches_played, wickets_taken, average_economy),
+          Batsman(name, date_of_birth, matches_played, total_runs, average_score) {}
+
+    void record_match(int runs, int wickets, double economy) override {
+        Cricketer::record_match(runs, wickets, economy);
+        update_bowling(wickets, economy);
+        update_batting(runs);
+    }
+
+    void show_details() const override;
+};
+
+class DoubleWicketPair {
+private:
+    Bowler* bowler;
+    Batsman* batsman;
+
+public:
+    DoubleWicketPair(Bowler* bowler, Batsman* batsman) : bowler(bowler), batsman(batsman) {}
+
+    Bowler* get_bowler() const { return bowler; }
+    Batsman* get_batsman() const { return batsman; }
+
+    void show_details() const;
+};
+
+// Players ordered by date of birth, kept as a sorted day-number column with a
+// parallel player column so range queries are two binary searches. Additions
+// are buffered and merged in one sort before the next query, so queries are
+// not safe to run concurrently with each other.
+class BirthDateIndex {
+private:
+    mutable std::vector<int32_t> birth_days;
+    mutable std::vector<Cricketer*> players;
+    mutable std::vector<std::pair<int32_t, Cricketer*>> pending;
+
+    void merge_pending() const;
+
+public:
+    void add(Cricketer* cricketer);
+
+    // Drops the player, e.g. when it is replaced. Returns false if absent.
+    bool remove(const Cricketer* cricketer);
+
+    // Players born on or between the two dates, oldest first.
+    std::vector<Cricketer*> born_between(Date from, Date to) const;
+
+    // Players whose age on the reference date is within [min_age, max_age].
+    std::vector<Cricketer*> aged_between(Date on, int min_age, int max_age) const;
+
+    size_t size() const { return players.size() + pending.size(); }
+};
+
+}  // namespace cricket
+
+#endif
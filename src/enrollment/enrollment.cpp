@@ -0,0 +1,130 @@
+#include "enrollment/enrollment.h"
+
+#include <algorithm>
+
+#include "instrument/instrument.h"
+
+namespace enrollment {
+
+void Student::enrollSubject(Subject* subject) {
+    INSTRUMENT_SCOPE("enrollment.enrollSubject");
+    mvcc::Write write(domain);
+    enrolledSubjects.append(write, subject);
+    subject->addStudent(this, write);
+    write.commit();
+}
+
+StudentList::~StudentList() {
+    for (std::map<int, Student*>::iterator it = students.begin(); it != students.end(); ++it) {
+        delete it->second;
+    }
+}
+
+bool StudentList::addStudent(int roll, const std::string& name) {
+    INSTRUMENT_SCOPE("enrollment.addStudent");
+    if (students.find(roll) != students.end()) {
+        return false;
+    }
+    mvcc::Write write(domain);
+    Student* student = new Student(roll, name, domain);
+    students[roll] = student;
+    log.append(write, student);
+    write.commit();
+    return true;
+}
+
+Student* StudentList::findStudentByRoll(int roll) {
+    std::map<int, Student*>::iterator it = students.find(roll);
+    return it != students.end() ? it->second : NULL;
+}
+
+void StudentList::listAllStudents(std::ostream& os) const {
+    INSTRUMENT_SCOPE("enrollment.listAllStudents");
+    for (std::map<int, Student*>::const_iterator it = students.begin(); it != students.end(); ++it) {
+        os << "Roll: " << it->first << ", Name: " << it->second->getName() << "\n";
+    }
+}
+
+SubjectList::~SubjectList() {
+    for (std::map<int, Subject*>::iterator it = subjects.begin(); it != subjects.end(); ++it) {
+        delete it->second;
+    }
+}
+
+bool SubjectList::addSubject(int code, const std::string& name) {
+    INSTRUMENT_SCOPE("enrollment.addSubject");
+    if (subjects.find(code) != subjects.end()) {
+        return false;
+    }
+    mvcc::Write write(domain);
+    Subject* subject = new Subject(code, name);
+    subjects[code] = subject;
+    log.append(write, subject);
+    write.commit();
+    return true;
+}
+
+Subject* SubjectList::findSubjectByCode(int code) {
+    std::map<int, Subject*>::iterator it = subjects.find(code);
+    return it != subjects.end() ? it->second : NULL;
+}
+
+void SubjectList::listAllSubjects(std::ostream& os) const {
+    INSTRUMENT_SCOPE("enrollment.listAllSubjects");
+    for (std::map<int, Subject*>::const_iterator it = subjects.begin(); it != subjects.end(); ++it) {
+        os << "Code: " << it->first << ", Name: " << it->second->getName() << "\n";
+    }
+}
+
+void printStudentSubjects(const StudentList& studentList, std::ostream& os) {
+    INSTRUMENT_SCOPE("enrollment.printStudentSubjects");
+    const std::map<int, Student*>& students = studentList.getStudents();
+    os << "\nStudent -> Subjects:\n";
+    for (std::map<int, Student*>::const_iterator it = students.begin(); it != students.end(); ++it) {
+        Student* student = it->second;
+        os << "Student: " << student->getName() << " (Roll: " << student->getRoll() << ")\nSubjects:\n";
+        student->getEnrolledSubjects().forEach([&](const Subject* subject) { os << "  - " << subject->getName() << "\n"; });
+    }
+}
+
+void printSubjectStudents(const SubjectList& subjectList, std::ostream& os) {
+    INSTRUMENT_SCOPE("enrollment.printSubjectStudents");
+    const std::map<int, Subject*>& subjects = subjectList.getSubjects();
+    os << "\nSubject -> Students:\n";
+    for (std::map<int, Subject*>::const_iterator it = subjects.begin(); it != subjects.end(); ++it) {
+        Subject* subject = it->second;
+        os << "Subject: " << subject->getName() << " (Code: " << subject->getCode() << ")\nStudents:\n";
+        subject->getEnrolledStudents().forEach([&](const Student* student) { os << "  - " << student->getName() << "\n"; });
+    }
+}
+
+void printStudentSubjects(const StudentList& studentList, const mvcc::Snapshot& snapshot, std::ostream& os) {
+    INSTRUMENT_SCOPE("enrollment.snapshotStudentSubjects");
+    // The log is in registration order; the live report is in roll order.
+    std::vector<const Student*> students;
+    studentList.getLog().forEach(snapshot, [&](const Student* student) { students.push_back(student); });
+    std::sort(students.begin(), students.end(), [](const Student* a, const Student* b) { return a->getRoll() < b->getRoll(); });
+
+    os << "\nStudent -> Subjects:\n";
+    for (std::vector<const Student*>::const_iterator it = students.begin(); it != students.end(); ++it) {
+        const Student* student = *it;
+        os << "Student: " << student->getName() << " (Roll: " << student->getRoll() << ")\nSubjects:\n";
+        student->getEnrolledSubjects().forEach(snapshot, [&](const Subject* subject) { os << "  - " << subject->getName() << "\n"; });
+    }
+}
+
+void printSubjectStudents(const SubjectList& subjectList, const mvcc::Snapshot& snapshot, std::ostream& os) {
+    INSTRUMENT_SCOPE("enrollment.snapshotSubjectStudents");
+    std::vector<const Subject*> subjects;
+    subjectList.getLog().forEach(snapshot, [&](const Subject* subject) { subjects.push_back(subject); });
+    std::sort(subjects.begin(), subjects.end(), [](const Subject* a, const Subject* b) { return a->getCode() < b->getCode(); });
+
+    os << "\nSubject -> Students:\n";
+    for (std::vector<const Subject*>::const_iterator it = subjects.begin(); it != subjects.end(); ++it) {
+        const Subject* subject = *it;
+        os << "Subject: " << subject->getName() << " (Code: " << subject->getCode() << ")\nStudents:\n";
+        subject->getEnrolledStudents().forEach(snapshot, [&](const Student* student) { os << "  - " << student->getName() << "\n"; });
+    }
+}
+
+}  // namespace enrollment
@@ -0,0 +1,128 @@
+/*
+Student/subject enrollment registry: students and subjects are kept in ordered
+maps keyed by roll number and subject code, and each enrollment links the two
+records both ways so either side of the relation can be listed directly.
+
+Enrollments are stored in multi-version logs, and registrations are recorded
+in one as well, so the roster reports can run against an mvcc::Snapshot
+while writers continue.
+*/
+#ifndef ENROLLMENT_ENROLLMENT_H
+#define ENROLLMENT_ENROLLMENT_H
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <string>
+
+#include "mvcc/mvcc.h"
+
+namespace enrollment {
+
+class Subject;
+
+class Student {
+private:
+    int roll;
+    std::string name;
+    mvcc::AppendLog<Subject*> enrolledSubjects;
+    mvcc::Domain& domain;
+
+public:
+    // domain is the registry pair's; see StudentList.
+    Student(int roll, const std::string& name, mvcc::Domain& domain) : roll(roll), name(name), domain(domain) {}
+
+    int getRoll() const { return roll; }
+    std::string getName() const { return name; }
+
+    void enrollSubject(Subject* subject);
+    // In enrollment order; read it with forEach(), as of a snapshot or latest.
+    const mvcc::AppendLog<Subject*>& getEnrolledSubjects() const {
+        return enrolledSubjects;
+    }
+};
+
+class Subject {
+private:
+    int code;
+    std::string name;
+    mvcc::AppendLog<Student*> enrolledStudents;
+
+public:
+    Subject(int code, const std::string& name) : code(code), name(name) {}
+
+    int getCode() const { return code; }
+    std::string getName() const { return name; }
+
+    // Called by Student::enrollSubject as part of its write.
+    void addStudent(Student* student, const mvcc::Write& write) {
+        enrolledStudents.append(write, student);
+    }
+
+    const mvcc::AppendLog<Student*>& getEnrolledStudents() const {
+        return enrolledStudents;
+    }
+};
+
+// A StudentList and the SubjectList built on its domain form one registry:
+// students may only enroll in subjects of their own pair, and one snapshot of
+// getDomain() sees both sides of each enrollment.
+class StudentList {
+private:
+    mvcc::Domain domain;
+    std::map<int, Student*> students;
+    mvcc::AppendLog<Student*> log;
+
+public:
+    StudentList() {}
+    ~StudentList();
+
+    StudentList(const StudentList&) = delete;
+    StudentList& operator=(const StudentList&) = delete;
+
+    // Returns false if a student with this roll number already exists.
+    bool addStudent(int roll, const std::string& name);
+    Student* findStudentByRoll(int roll);
+    void listAllStudents(std::ostream& os = std::cout) const;
+
+    const std::map<int, Student*>& getStudents() const { return students; }
+    const mvcc::AppendLog<Student*>& getLog() const { return log; }
+    mvcc::Domain& getDomain() { return domain; }
+};
+
+class SubjectList {
+private:
+    mvcc::Domain& domain;
+    std::map<int, Subject*> subjects;
+    mvcc::AppendLog<Subject*> log;
+
+public:
+    // domain is the paired StudentList's, which must outlive this list.
+    explicit SubjectList(mvcc::Domain& domain) : domain(domain) {}
+    ~SubjectList();
+
+    SubjectList(const SubjectList&) = delete;
+    SubjectList& operator=(const SubjectList&) = delete;
+
+    // Returns false if a subject with this code already exists.
+    bool addSubject(int code, const std::string& name);
+    Subject* findSubjectByCode(int code);
+    void listAllSubjects(std::ostream& os = std::cout) const;
+
+    const std::map<int, Subject*>& getSubjects() const { return subjects; }
+    const mvcc::AppendLog<Subject*>& getLog() const { return log; }
+};
+
+// Roster reports: every student with the subjects they selected, and every
+// subject with the students who selected it.
+void printStudentSubjects(const StudentList& studentList, std::ostream& os = std::cout);
+void printSubjectStudents(const SubjectList& subjectList, std::ostream& os = std::cout);
+
+// The same reports as of a snapshot of the pair's domain. They take no lock
+// and may run on another thread while the lists are being updated.
+void printStudentSubjects(const StudentList& studentList, const mvcc::Snapshot& snapshot, std::ostream& os = std::cout);
+void printSubjectStudents(const SubjectList& subjectList, const mvcc::Snapshot& snapshot, std::ostream& os = std::cout);
+
+}  // namespace enrollment
+
+#endif
@@ -0,0 +1,275 @@
+#include "instrument/instrument.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace instrument {
+
+namespace {
+
+struct ProbeSummary {
+    std::string name;
+    uint64_t count;
+    uint64_t totalTicks;
+    uint64_t maxTicks;
+    std::vector<uint64_t> histogram;
+
+    ProbeSummary() : count(0), totalTicks(0), maxTicks(0), histogram(kBuckets, 0) {}
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<ThreadStats*> threads;
+    std::vector<ThreadStats*> spare;
+    std::vector<ProbeSummary> retired;
+    ThreadStats* orphan;
+    uint64_t startTicks;
+    std::chrono::steady_clock::time_point startTime;
+
+    Registry() : names(1), retired(kMaxProbes), orphan(nullptr), startTicks(now()), startTime(std::chrono::steady_clock::now()) {}
+};
+
+// Leaked on purpose: probes may fire from static destructors and the
+// at-exit dump runs after main returns.
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+// Exact call count, recovered from the number of samples and the countdown
+// to the next one.
+uint64_t callsOf(const ThreadStats* stats, int probe) {
+    uint64_t samples = stats->samples[probe].load(std::memory_order_relaxed);
+    if (samples == 0) return 0;
+    return (samples - 1) * kSampleEvery + 1 + (kSampleEvery - stats->countdown[probe].load(std::memory_order_relaxed));
+}
+
+void accumulate(ProbeSummary& summary, const ThreadStats* stats, int probe) {
+    summary.count += callsOf(stats, probe);
+    summary.totalTicks += stats->totalTicks[probe].load(std::memory_order_relaxed);
+    uint64_t maxTicks = stats->maxTicks[probe].load(std::memory_order_relaxed);
+    if (maxTicks > summary.maxTicks) summary.maxTicks = maxTicks;
+    const std::atomic<uint32_t>* histogram = stats->histogram[probe].load(std::memory_order_acquire);
+    if (!histogram) return;
+    for (int b = 0; b < kBuckets; ++b) summary.histogram[b] += histogram[b].load(std::memory_order_relaxed);
+}
+
+// Runs when a registered thread exits: its totals move into the registry and
+// its slots go back on the spare list.
+struct ThreadExit {
+    ThreadStats* stats;
+
+    ThreadExit() : stats(nullptr) {}
+    ~ThreadExit();
+};
+
+ThreadExit::~ThreadExit() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (int p = 1; p < kMaxProbes; ++p) accumulate(reg.retired[p], stats, p);
+    stats->clear();
+    for (size_t t = 0; t < reg.threads.size(); ++t) {
+        if (reg.threads[t] == stats) {
+            reg.threads.erase(reg.threads.begin() + t);
+            break;
+        }
+    }
+    reg.spare.push_back(stats);
+    // Probes fired by later thread-exit destructors land in a shared slot
+    // set that is never released.
+    if (!reg.orphan) {
+        reg.orphan = new ThreadStats();
+        reg.threads.push_back(reg.orphan);
+    }
+    currentThreadStats = reg.orphan;
+}
+
+double nanosPerTick() {
+    Registry& reg = registry();
+    std::chrono::steady_clock::time_point endTime = std::chrono::steady_clock::now();
+    if (endTime - reg.startTime < std::chrono::milliseconds(10)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        endTime = std::chrono::steady_clock::now();
+    }
+    uint64_t endTicks = now();
+    double nanos = std::chrono::duration<double, std::nano>(endTime - reg.startTime).count();
+    return endTicks > reg.startTicks ? nanos / static_cast<double>(endTicks - reg.startTicks) : 1.0;
+}
+
+std::vector<ProbeSummary> collect() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    std::vector<ProbeSummary> summaries;
+    for (size_t p = 1; p < reg.names.size(); ++p) {
+        summaries.push_back(reg.retired[p]);
+        ProbeSummary& summary = summaries.back();
+        summary.name = reg.names[p];
+        for (size_t t = 0; t < reg.threads.size(); ++t) accumulate(summary, reg.threads[t], static_cast<int>(p));
+    }
+    return summaries;
+}
+
+uint64_t timedCount(const ProbeSummary& summary) {
+    uint64_t total = 0;
+    for (int b = 0; b < kBuckets; ++b) total += summary.histogram[b];
+    return total;
+}
+
+// Lower bound of the bucket holding the given quantile.
+uint64_t quantileTicks(const ProbeSummary& summary, double quantile) {
+    uint64_t total = timedCount(summary);
+    if (total == 0) return 0;
+    uint64_t rank = static_cast<uint64_t>(quantile * static_cast<double>(total - 1));
+    uint64_t seen = 0;
+    for (int b = 0; b < kBuckets; ++b) {
+        seen += summary.histogram[b];
+        if (seen > rank) return bucketLowerBound(b);
+    }
+    return summary.maxTicks;
+}
+
+void dumpAtExit() {
+    const char* format = std::getenv("OOP_INSTRUMENT_DUMP");
+    if (!format) return;
+    if (std::strcmp(format, "json") == 0) {
+        dumpJson(std::cerr);
+    } else {
+        dumpText(std::cerr);
+    }
+}
+
+}  // namespace
+
+ThreadStats::ThreadStats() {
+    for (int p = 0; p < kMaxProbes; ++p) histogram[p].store(nullptr, std::memory_order_relaxed);
+    clear();
+}
+
+ThreadStats::~ThreadStats() {
+    for (int p = 0; p < kMaxProbes; ++p) delete[] histogram[p].load(std::memory_order_relaxed);
+}
+
+// Keeps allocated histograms, zeroed, for the next thread to use the slots.
+void ThreadStats::clear() {
+    for (int p = 0; p < kMaxProbes; ++p) {
+        countdown[p].store(1, std::memory_order_relaxed);
+        samples[p].store(0, std::memory_order_relaxed);
+        totalTicks[p].store(0, std::memory_order_relaxed);
+        maxTicks[p].store(0, std::memory_order_relaxed);
+        std::atomic<uint32_t>* buckets = histogram[p].load(std::memory_order_relaxed);
+        if (!buckets) continue;
+        for (int b = 0; b < kBuckets; ++b) buckets[b].store(0, std::memory_order_relaxed);
+    }
+}
+
+int registerProbe(const char* name) {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t p = 1; p < reg.names.size(); ++p) {
+        if (reg.names[p] == name) return static_cast<int>(p);
+    }
+    if (reg.names.size() >= static_cast<size_t>(kMaxProbes)) return 0;
+    if (reg.names.size() == 1) std::atexit(dumpAtExit);
+    reg.names.push_back(name);
+    return static_cast<int>(reg.names.size() - 1);
+}
+
+ThreadStats* registerThread() {
+    static thread_local ThreadExit exitHook;
+    Registry& reg = registry();
+    ThreadStats* stats = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        if (reg.spare.empty()) {
+            stats = new ThreadStats();
+        } else {
+            stats = reg.spare.back();
+            reg.spare.pop_back();
+        }
+        reg.threads.push_back(stats);
+    }
+    exitHook.stats = stats;
+    currentThreadStats = stats;
+    return stats;
+}
+
+void recordSample(ThreadStats* stats, int probe, uint64_t ticks) {
+    bump(stats->totalTicks[probe], ticks);
+    if (ticks > stats->maxTicks[probe].load(std::memory_order_relaxed)) {
+        stats->maxTicks[probe].store(ticks, std::memory_order_relaxed);
+    }
+    std::atomic<uint32_t>* buckets = stats->histogram[probe].load(std::memory_order_relaxed);
+    if (!buckets) {
+        buckets = new std::atomic<uint32_t>[kBuckets]();
+        stats->histogram[probe].store(buckets, std::memory_order_release);
+    }
+    std::atomic<uint32_t>& bucket = buckets[bucketFor(ticks)];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void dumpText(std::ostream& os) {
+    double scale = nanosPerTick();
+    std::vector<ProbeSummary> summaries = collect();
+    os << "probe                                  count     mean(ns)      p50(ns)      p99(ns)      max(ns)\n";
+    for (size_t p = 0; p < summaries.size(); ++p) {
+        const ProbeSummary& s = summaries[p];
+        if (s.count == 0) continue;
+        uint64_t timed = timedCount(s);
+        char line[256];
+        if (timed == 0) {
+            std::snprintf(line, sizeof(line), "%-32s %12llu\n", s.name.c_str(), static_cast<unsigned long long>(s.count));
+        } else {
+            std::snprintf(line, sizeof(line), "%-32s %12llu %12.1f %12.1f %12.1f %12.1f\n", s.name.c_str(),
+                          static_cast<unsigned long long>(s.count), s.totalTicks * scale / timed,
+                          quantileTicks(s, 0.50) * scale, quantileTicks(s, 0.99) * scale, s.maxTicks * scale);
+        }
+        os << line;
+    }
+}
+
+void dumpJson(std::ostream& os) {
+    double scale = nanosPerTick();
+    std::vector<ProbeSummary> summaries = collect();
+    os << "{\"probes\":[";
+    bool first = true;
+    for (size_t p = 0; p < summaries.size(); ++p) {
+        const ProbeSummary& s = summaries[p];
+        if (s.count == 0) continue;
+        os << (first ? "" : ",") << "\n  {\"name\":\"" << s.name << "\",\"count\":" << s.count;
+        first = false;
+        uint64_t timed = timedCount(s);
+        if (timed != 0) {
+            os << ",\"samples\":" << timed
+               << ",\"mean_ns\":" << s.totalTicks * scale / timed
+               << ",\"p50_ns\":" << quantileTicks(s, 0.50) * scale
+               << ",\"p90_ns\":" << quantileTicks(s, 0.90) * scale
+               << ",\"p99_ns\":" << quantileTicks(s, 0.99) * scale
+               << ",\"max_ns\":" << s.maxTicks * scale
+               << ",\"histogram\":[";
+            bool firstBucket = true;
+            for (int b = 0; b < kBuckets; ++b) {
+                if (s.histogram[b] == 0) continue;
+                os << (firstBucket ? "" : ",") << "[" << bucketLowerBound(b) * scale << "," << s.histogram[b] << "]";
+                firstBucket = false;
+            }
+            os << "]";
+        }
+        os << "}";
+    }
+    os << "\n]}\n";
+}
+
+void reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (size_t t = 0; t < reg.threads.size(); ++t) reg.threads[t]->clear();
+    reg.retired.assign(kMaxProbes, ProbeSummary());
+}
+
+}  // namespace instrument
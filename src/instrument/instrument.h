@@ -0,0 +1,193 @@
+/*
+Hot-path instrumentation: named probes that count calls and record latency
+into per-thread log-linear histograms. Recording touches only the calling
+thread's slots; dumps merge all threads.
+
+Build with OOP_INSTRUMENTATION=0 (CMake option OOP_INSTRUMENTATION=OFF) and
+the INSTRUMENT_* macros expand to nothing. One call in
+2^OOP_INSTRUMENT_SAMPLE_SHIFT per probe and thread is sampled (and timed, for
+INSTRUMENT_SCOPE); the other calls only decrement a thread-local countdown,
+from which dumps still recover exact call counts. Setting
+OOP_INSTRUMENT_DUMP=text or =json in the environment prints a report to stderr
+at exit.
+*/
+#ifndef INSTRUMENT_INSTRUMENT_H
+#define INSTRUMENT_INSTRUMENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef OOP_INSTRUMENTATION
+#define OOP_INSTRUMENTATION 0
+#endif
+
+#ifndef OOP_INSTRUMENT_SAMPLE_SHIFT
+#define OOP_INSTRUMENT_SAMPLE_SHIFT 4
+#endif
+
+namespace instrument {
+
+const int kMaxProbes = 64;
+const uint32_t kSampleEvery = uint32_t(1) << OOP_INSTRUMENT_SAMPLE_SHIFT;
+
+// Values below 2 * kSubBuckets get their own bucket; above that each power of
+// two is split into kSubBuckets linear buckets (about 6% relative error).
+// Values of 2^kMaxValueBits and more share the last bucket.
+const int kSubBucketBits = 4;
+const int kSubBuckets = 1 << kSubBucketBits;
+const int kMaxValueBits = 40;
+const int kBuckets = (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets;
+
+inline int bucketFor(uint64_t value) {
+    if (value < 2 * kSubBuckets) return static_cast<int>(value);
+    if (value >> kMaxValueBits) return kBuckets - 1;
+    int shift = 63 - __builtin_clzll(value) - kSubBucketBits;
+    return (shift + 1) * kSubBuckets + static_cast<int>((value >> shift) - kSubBuckets);
+}
+
+inline uint64_t bucketLowerBound(int bucket) {
+    if (bucket < 2 * kSubBuckets) return static_cast<uint64_t>(bucket);
+    int shift = bucket / kSubBuckets - 1;
+    return static_cast<uint64_t>(bucket % kSubBuckets + kSubBuckets) << shift;
+}
+
+// Slots written by exactly one thread. Relaxed load/store pairs keep the
+// updates free of locked instructions while letting a dump read them.
+// Histograms are allocated on a probe's first sample in the thread.
+struct ThreadStats {
+    std::atomic<uint32_t> countdown[kMaxProbes];
+    std::atomic<uint64_t> samples[kMaxProbes];
+    std::atomic<uint64_t> totalTicks[kMaxProbes];
+    std::atomic<uint64_t> maxTicks[kMaxProbes];
+    std::atomic<std::atomic<uint32_t>*> histogram[kMaxProbes];
+
+    ThreadStats();
+    ~ThreadStats();
+    void clear();
+};
+
+// Returns a stable id for the probe name; repeated calls with the same name
+// return the same id. Id 0 is a discard slot that is never reported: it is
+// returned once kMaxProbes - 1 names are registered.
+int registerProbe(const char* name);
+
+// Id of one INSTRUMENT_* site, registered during static initialisation so the
+// hot path reads a plain global. Site is a local class naming the probe. A
+// site reached before its id is initialised records into the discard slot.
+template <typename Site>
+struct Probe {
+    static const int id;
+};
+
+template <typename Site>
+const int Probe<Site>::id = registerProbe(Site::probeName());
+
+// Slots for the calling thread, set up on its first probe. They are folded
+// into the registry and reused when the thread exits.
+inline thread_local ThreadStats* currentThreadStats = nullptr;
+
+ThreadStats* registerThread();
+
+inline ThreadStats* threadStats() {
+    ThreadStats* stats = currentThreadStats;
+    if (__builtin_expect(stats == nullptr, 0)) stats = registerThread();
+    return stats;
+}
+
+inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+inline void bump(std::atomic<uint64_t>& slot, uint64_t by) {
+    slot.store(slot.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+// Counts down to the next sample; returns true on a sampled call. The first
+// call of each probe in a thread is always sampled.
+inline bool tick(ThreadStats* stats, int probe) {
+    uint32_t left = stats->countdown[probe].load(std::memory_order_relaxed) - 1;
+    if (__builtin_expect(left != 0, 1)) {
+        stats->countdown[probe].store(left, std::memory_order_relaxed);
+        return false;
+    }
+    stats->countdown[probe].store(kSampleEvery, std::memory_order_relaxed);
+    bump(stats->samples[probe], 1);
+    return true;
+}
+
+inline void count(int probe) {
+    tick(threadStats(), probe);
+}
+
+void recordSample(ThreadStats* stats, int probe, uint64_t ticks);
+
+// Times the enclosing scope on sampled calls only, so the clock is read twice
+// per 2^OOP_INSTRUMENT_SAMPLE_SHIFT calls.
+class ScopedTimer {
+private:
+    ThreadStats* stats;
+    int probe;
+    uint64_t start;
+
+public:
+    explicit ScopedTimer(int probe) : stats(nullptr), probe(probe), start(0) {
+        ThreadStats* current = threadStats();
+        if (__builtin_expect(tick(current, probe), 0)) {
+            stats = current;
+            start = now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (__builtin_expect(stats != nullptr, 0)) recordSample(stats, probe, now() - start);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// Reports merge every thread that has recorded so far, including exited
+// ones. Latencies are converted to nanoseconds.
+void dumpText(std::ostream& os);
+void dumpJson(std::ostream& os);
+
+// Zeroes every thread's slots. Only meaningful while no thread is recording.
+void reset();
+
+}  // namespace instrument
+
+#define INSTRUMENT_CONCAT_INNER(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_INNER(a, b)
+
+#if OOP_INSTRUMENTATION
+#define INSTRUMENT_SITE(site, name)                        \
+    struct site {                                          \
+        static const char* probeName() { return name; }    \
+    }
+// Times the rest of the enclosing scope under the given probe name.
+#define INSTRUMENT_SCOPE(name)                                                   \
+    INSTRUMENT_SITE(INSTRUMENT_CONCAT(InstrumentSite_, __LINE__), name);         \
+    instrument::ScopedTimer INSTRUMENT_CONCAT(instrumentTimer_, __LINE__)(       \
+        instrument::Probe<INSTRUMENT_CONCAT(InstrumentSite_, __LINE__)>::id)
+// Counts an event without timing it.
+#define INSTRUMENT_COUNT(name)                                   \
+    do {                                                         \
+        INSTRUMENT_SITE(InstrumentSite, name);                   \
+        instrument::count(instrument::Probe<InstrumentSite>::id); \
+    } while (0)
+#else
+#define INSTRUMENT_SCOPE(name) ((void)0)
+#define INSTRUMENT_COUNT(name) ((void)0)
+#endif
+
+#endif
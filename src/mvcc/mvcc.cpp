@@ -0,0 +1,76 @@
+#include "mvcc/mvcc.h"
+
+#include <limits>
+#include <thread>
+
+namespace mvcc {
+
+namespace {
+
+const uint64_t kFree = std::numeric_limits<uint64_t>::max();
+const uint64_t kCollectEvery = 256;
+
+}  // namespace
+
+Domain::Domain() : clock(0), commits(0) {
+    for (int i = 0; i < kMaxReaders; ++i) readers[i].store(kFree, std::memory_order_relaxed);
+}
+
+void Domain::commit(uint64_t version) {
+    // Release is enough here; oldestPinned() fences before it scans readers.
+    clock.store(version, std::memory_order_release);
+    if (++commits % kCollectEvery == 0 && !dirty.empty()) collect();
+}
+
+uint64_t Domain::oldestPinned() const {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    uint64_t oldest = clock.load();
+    for (int i = 0; i < kMaxReaders; ++i) {
+        uint64_t pinned = readers[i].load();
+        if (pinned < oldest) oldest = pinned;
+    }
+    return oldest;
+}
+
+void Domain::retire(Collectable* c) {
+    if (c->queued) return;
+    c->queued = true;
+    dirty.push_back(c);
+}
+
+void Domain::collect() {
+    uint64_t oldest = oldestPinned();
+    size_t kept = 0;
+    for (size_t i = 0; i < dirty.size(); ++i) {
+        if (dirty[i]->collect(oldest)) {
+            dirty[kept++] = dirty[i];
+        } else {
+            dirty[i]->queued = false;
+        }
+    }
+    dirty.resize(kept);
+}
+
+// The slot is published before the version is read, so a writer computing
+// oldestPinned() either sees this reader or has already advanced the clock
+// past anything it frees.
+Snapshot::Snapshot(Domain& domain) : domain(&domain), slot(-1), version(0) {
+    while (slot < 0) {
+        uint64_t announced = domain.clock.load();
+        for (int i = 0; i < kMaxReaders; ++i) {
+            uint64_t expected = kFree;
+            if (domain.readers[i].compare_exchange_strong(expected, announced)) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) std::this_thread::yield();
+    }
+    version = domain.clock.load();
+}
+
+Snapshot::~Snapshot() {
+    domain->readers[slot].store(kFree);
+}
+
+}  // namespace mvcc
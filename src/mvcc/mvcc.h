@@ -0,0 +1,282 @@
+/*
+Multi-version snapshots for the in-memory registries. A Domain hands out
+increasing versions to writers and lets readers pin a version with a
+Snapshot; data kept in AppendLog (grow-only lists) and Versioned (cells with
+a version chain) can then be read as of that version without taking any lock
+while writers continue.
+
+Writers are serialised per domain by Write. Superseded versions are freed by
+the writer once no pinned snapshot can reach them.
+*/
+#ifndef MVCC_MVCC_H
+#define MVCC_MVCC_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mvcc {
+
+const int kMaxReaders = 64;
+
+class Collectable {
+public:
+    Collectable() : queued(false) {}
+    virtual ~Collectable() {}
+
+    // Frees versions that no snapshot at or after oldest can reach. Returns
+    // true while superseded versions remain that a later pass must revisit.
+    virtual bool collect(uint64_t oldest) = 0;
+
+private:
+    friend class Domain;
+    bool queued;
+};
+
+class Domain {
+private:
+    std::atomic<uint64_t> clock;
+    std::atomic<uint64_t> readers[kMaxReaders];
+    std::mutex writer;
+    std::vector<Collectable*> dirty;
+    uint64_t commits;
+
+    friend class Write;
+    friend class Snapshot;
+
+    void commit(uint64_t version);
+
+public:
+    Domain();
+
+    Domain(const Domain&) = delete;
+    Domain& operator=(const Domain&) = delete;
+
+    uint64_t currentVersion() const { return clock.load(); }
+
+    // Oldest version any pinned snapshot may read; the current version when
+    // no snapshot is pinned.
+    uint64_t oldestPinned() const;
+
+    // Called by writers after superseding a version in c.
+    void retire(Collectable* c);
+
+    // Frees everything unreachable now. Runs automatically every few hundred
+    // commits; must be called by the writer (inside a Write) if used directly.
+    void collect();
+};
+
+// Scope of one atomic update. Everything written with it becomes visible to
+// snapshots together at commit(), which the writer calls once it is done. A
+// Write left without commit(), e.g. by an exception, publishes nothing, but
+// nothing is rolled back either: what it wrote is published by the next
+// commit. Writers therefore must not throw once they have written; validate
+// input first. The registries can only throw there on allocation failure.
+class Write {
+private:
+    std::lock_guard<std::mutex> lock;
+    Domain& domain;
+    uint64_t version;
+
+public:
+    explicit Write(Domain& domain)
+        : lock(domain.writer), domain(domain), version(domain.clock.load(std::memory_order_relaxed) + 1) {}
+
+    void commit() { domain.commit(version); }
+
+    Write(const Write&) = delete;
+    Write& operator=(const Write&) = delete;
+
+    uint64_t getVersion() const { return version; }
+    Domain& getDomain() const { return domain; }
+};
+
+// Pins a point-in-time view. Cheap to take; hold it for the duration of a
+// report and release it promptly, since it keeps old versions alive.
+class Snapshot {
+private:
+    Domain* domain;
+    int slot;
+    uint64_t version;
+
+public:
+    explicit Snapshot(Domain& domain);
+    ~Snapshot();
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    uint64_t getVersion() const { return version; }
+};
+
+// Grow-only list. The single writer appends under a Write; readers see the
+// entries committed at or before their snapshot. Storage is a chain of
+// chunks that never move, doubling in size from a small first chunk. It can
+// also serve as the registry's only copy of a list: the writer, or a reader
+// holding a lock that excludes writers, reads it all with the latest view.
+template <typename T>
+class AppendLog {
+private:
+    struct Entry {
+        uint64_t version;
+        T value;
+    };
+
+    struct Chunk {
+        std::unique_ptr<Entry[]> entries;
+        size_t capacity;
+        std::atomic<Chunk*> next;
+
+        explicit Chunk(size_t capacity) : entries(new Entry[capacity]), capacity(capacity), next(nullptr) {}
+    };
+
+    std::atomic<Chunk*> head;
+    Chunk* tail;
+    size_t tailUsed;
+    std::atomic<size_t> count;
+
+    // Visits entries up to the version until visit returns true; returns
+    // whether it did.
+    template <typename Visit>
+    bool visitUpTo(uint64_t version, Visit visit) const {
+        size_t remaining = count.load(std::memory_order_acquire);
+        for (const Chunk* chunk = head.load(std::memory_order_acquire); chunk && remaining > 0; chunk = chunk->next.load(std::memory_order_acquire)) {
+            size_t n = remaining < chunk->capacity ? remaining : chunk->capacity;
+            for (size_t i = 0; i < n; ++i) {
+                // Versions are appended in increasing order.
+                if (chunk->entries[i].version > version) return false;
+                if (visit(chunk->entries[i].value)) return true;
+            }
+            remaining -= n;
+        }
+        return false;
+    }
+
+public:
+    // The first chunk is allocated on the first append, so empty logs cost
+    // nothing beyond the object itself.
+    explicit AppendLog(size_t firstChunk = 4)
+        : head(nullptr), tail(nullptr), tailUsed(firstChunk), count(0) {}
+
+    ~AppendLog() {
+        Chunk* chunk = head.load(std::memory_order_relaxed);
+        while (chunk) {
+            Chunk* next = chunk->next.load(std::memory_order_relaxed);
+            delete chunk;
+            chunk = next;
+        }
+    }
+
+    AppendLog(const AppendLog&) = delete;
+    AppendLog& operator=(const AppendLog&) = delete;
+
+    void append(const Write& write, const T& value) {
+        if (!tail) {
+            tail = new Chunk(tailUsed);
+            head.store(tail, std::memory_order_release);
+            tailUsed = 0;
+        } else if (tailUsed == tail->capacity) {
+            Chunk* chunk = new Chunk(tail->capacity * 2);
+            tail->next.store(chunk, std::memory_order_release);
+            tail = chunk;
+            tailUsed = 0;
+        }
+        tail->entries[tailUsed].version = write.getVersion();
+        tail->entries[tailUsed].value = value;
+        ++tailUsed;
+        count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Latest view: the number of entries and every entry in append order,
+    // committed or not.
+    size_t size() const { return count.load(std::memory_order_acquire); }
+    template <typename Visit>
+    void forEach(Visit visit) const {
+        visitUpTo(UINT64_MAX, [&](const T& value) { visit(value); return false; });
+    }
+
+    // Latest view: the first entry for which match returns true, or T() if
+    // there is none.
+    template <typename Match>
+    T findFirst(Match match) const {
+        T found = T();
+        visitUpTo(UINT64_MAX, [&](const T& value) {
+            if (!match(value)) return false;
+            found = value;
+            return true;
+        });
+        return found;
+    }
+
+    // Visits, in append order, every entry visible to the snapshot.
+    template <typename Visit>
+    void forEach(const Snapshot& snapshot, Visit visit) const {
+        visitUpTo(snapshot.getVersion(), [&](const T& value) { visit(value); return false; });
+    }
+};
+
+// Single value with a version chain, newest first. The writer reads latest();
+// readers read as of their snapshot.
+template <typename T>
+class Versioned : public Collectable {
+private:
+    struct Version {
+        uint64_t begin;
+        T value;
+        std::atomic<Version*> older;
+
+        Version(uint64_t begin, const T& value, Version* older) : begin(begin), value(value), older(older) {}
+    };
+
+    std::atomic<Version*> newest;
+
+    static void destroy(Version* version) {
+        while (version) {
+            Version* older = version->older.load(std::memory_order_relaxed);
+            delete version;
+            version = older;
+        }
+    }
+
+public:
+    // The initial value is visible to every snapshot.
+    explicit Versioned(const T& initial = T()) : newest(new Version(0, initial, nullptr)) {}
+    ~Versioned() { destroy(newest.load(std::memory_order_relaxed)); }
+
+    Versioned(const Versioned&) = delete;
+    Versioned& operator=(const Versioned&) = delete;
+
+    const T& latest() const { return newest.load(std::memory_order_relaxed)->value; }
+
+    void set(const Write& write, const T& value) {
+        Version* current = newest.load(std::memory_order_relaxed);
+        if (current->begin == write.getVersion()) {
+            // Not yet committed, so no snapshot can be reading it.
+            current->value = value;
+            return;
+        }
+        newest.store(new Version(write.getVersion(), value, current), std::memory_order_release);
+        write.getDomain().retire(this);
+    }
+
+    const T& get(const Snapshot& snapshot) const {
+        Version* version = newest.load(std::memory_order_acquire);
+        while (version->begin > snapshot.getVersion()) version = version->older.load(std::memory_order_acquire);
+        return version->value;
+    }
+
+    bool collect(uint64_t oldest) override {
+        Version* head = newest.load(std::memory_order_relaxed);
+        Version* keep = head;
+        while (keep->begin > oldest) keep = keep->older.load(std::memory_order_relaxed);
+        destroy(keep->older.exchange(nullptr, std::memory_order_relaxed));
+        return keep != head;
+    }
+};
+
+}  // namespace mvcc
+
+#endif
@@ -0,0 +1,42 @@
+#include "payroll/payroll.h"
+
+#include "instrument/instrument.h"
+
+namespace payroll {
+
+Payroll::~Payroll() {
+    log.forEach([](Employee* employee) { delete employee; });
+}
+
+void Payroll::addEmployee(Employee* employee) {
+    INSTRUMENT_SCOPE("payroll.addEmployee");
+    mvcc::Write write(domain);
+    log.append(write, employee);
+    write.commit();
+}
+
+double Payroll::totalSalary() const {
+    INSTRUMENT_SCOPE("payroll.totalSalary");
+    double total = 0.0;
+    log.forEach([&](const Employee* employee) { total += employee->calculateSalary(); });
+    return total;
+}
+
+void Payroll::displayAll(std::ostream& os) const {
+    INSTRUMENT_SCOPE("payroll.displayAll");
+    log.forEach([&](const Employee* employee) { employee->display(os); });
+}
+
+double Payroll::totalSalary(const mvcc::Snapshot& snapshot) const {
+    INSTRUMENT_SCOPE("payroll.snapshotTotalSalary");
+    double total = 0.0;
+    log.forEach(snapshot, [&](const Employee* employee) { total += employee->calculateSalary(); });
+    return total;
+}
+
+void Payroll::displayAll(const mvcc::Snapshot& snapshot, std::ostream& os) const {
+    INSTRUMENT_SCOPE("payroll.snapshotDisplayAll");
+    log.forEach(snapshot, [&](const Employee* employee) { employee->display(os); });
+}
+
+}  // namespace payroll
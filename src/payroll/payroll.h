@@ -0,0 +1,95 @@
+/*
+Payroll engine: permanent and contractual employees with their salary rules,
+and the Payroll register that owns them. Employees are kept in an
+mvcc::AppendLog so listings can run against a snapshot while hiring continues;
+the plain listings read its latest view.
+*/
+#ifndef PAYROLL_PAYROLL_H
+#define PAYROLL_PAYROLL_H
+
+#include <iostream>
+#include <string>
+
+#include "mvcc/mvcc.h"
+
+namespace payroll {
+
+class Employee {
+protected:
+    std::string empId;
+    std::string name;
+    std::string designation;
+    double basicPay;
+
+public:
+    Employee(const std::string& empId, const std::string& name, const std::string& designation, double basicPay)
+        : empId(empId), name(name), designation(designation), basicPay(basicPay) {}
+
+    virtual ~Employee() {}
+
+    virtual double calculateSalary() const = 0;
+
+    const std::string& getEmpId() const { return empId; }
+
+    void display(std::ostream& os = std::cout) const {
+        os << "Employee ID: " << empId
+           << "\nName: " << name
+           << "\nDesignation: " << designation
+           << "\nSalary: " << calculateSalary() << "\n\n";
+    }
+};
+
+class PermanentEmployee : public Employee {
+public:
+    PermanentEmployee(const std::string& empId, const std::string& name, const std::string& designation, double basicPay)
+        : Employee(empId, name, designation, basicPay) {}
+
+    double calculateSalary() const {
+        return basicPay + (0.3 * basicPay) + (0.8 * basicPay);
+    }
+};
+
+class ContractualEmployee : public Employee {
+private:
+    double allowance;
+
+public:
+    ContractualEmployee(const std::string& empId, const std::string& name, const std::string& designation, double basicPay, double allowance)
+        : Employee(empId, name, designation, basicPay), allowance(allowance) {}
+
+    double calculateSalary() const {
+        return basicPay + allowance;
+    }
+};
+
+class Payroll {
+private:
+    mutable mvcc::Domain domain;
+    mvcc::AppendLog<Employee*> log;
+
+public:
+    Payroll() {}
+    ~Payroll();
+
+    Payroll(const Payroll&) = delete;
+    Payroll& operator=(const Payroll&) = delete;
+
+    // Takes ownership of the employee.
+    void addEmployee(Employee* employee);
+
+    double totalSalary() const;
+    void displayAll(std::ostream& os = std::cout) const;
+
+    // In hiring order; read it with forEach(), as of a snapshot or latest.
+    const mvcc::AppendLog<Employee*>& getEmployees() const { return log; }
+
+    // Snapshot counterparts: lock-free and safe to run while another thread
+    // adds employees.
+    mvcc::Domain& getDomain() const { return domain; }
+    double totalSalary(const mvcc::Snapshot& snapshot) const;
+    void displayAll(const mvcc::Snapshot& snapshot, std::ostream& os = std::cout) const;
+};
+
+}  // namespace payroll
+
+#endif
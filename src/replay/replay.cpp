@@ -0,0 +1,228 @@
+#include "replay/replay.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "instrument/instrument.h"
+
+namespace replay {
+
+namespace {
+
+bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+}  // namespace
+
+std::string_view Command::tail(int i) const {
+    if (i >= argc || i >= kMaxArgs) return std::string_view();
+    size_t begin = args[i].data() - line.data();
+    size_t end = line.size();
+    while (end > begin && isSpace(line[end - 1])) --end;
+    return line.substr(begin, end - begin);
+}
+
+bool toInt(std::string_view text, int& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+bool toDouble(std::string_view text, double& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+namespace {
+
+[[noreturn]] void badArgument(const Command& command, int i, const char* expected) {
+    throw std::invalid_argument(std::string(command.op) + ": argument " + std::to_string(i + 1) + " must be " + expected);
+}
+
+bool present(const Command& command, int i) {
+    return i < command.argc && i < kMaxArgs;
+}
+
+}  // namespace
+
+int intArg(const Command& command, int i) {
+    int value;
+    if (!present(command, i) || !toInt(command.args[i], value)) badArgument(command, i, "an integer");
+    return value;
+}
+
+double doubleArg(const Command& command, int i) {
+    double value;
+    if (!present(command, i) || !toDouble(command.args[i], value)) badArgument(command, i, "a number");
+    return value;
+}
+
+std::string stringArg(const Command& command, int i) {
+    if (!present(command, i)) badArgument(command, i, "present");
+    return std::string(command.args[i]);
+}
+
+std::string_view viewArg(const Command& command, int i) {
+    if (!present(command, i)) badArgument(command, i, "present");
+    return command.args[i];
+}
+
+std::string tailArg(const Command& command, int i) {
+    if (!present(command, i)) badArgument(command, i, "present");
+    return std::string(command.tail(i));
+}
+
+void unknownCommand(const Command& command) {
+    throw std::invalid_argument("unknown command '" + std::string(command.op) + "'");
+}
+
+void expectArgs(const Command& command, int count) {
+    if (command.argc != count) {
+        throw std::invalid_argument(std::string(command.op) + ": expected " + std::to_string(count) + " arguments, got " +
+                                    std::to_string(command.argc));
+    }
+}
+
+void expectTailArgs(const Command& command, int count) {
+    if (command.argc < count) {
+        throw std::invalid_argument(std::string(command.op) + ": expected at least " + std::to_string(count) + " arguments, got " +
+                                    std::to_string(command.argc));
+    }
+}
+
+Trace::~Trace() {
+    if (data && size) munmap(const_cast<char*>(data), size);
+}
+
+bool Trace::open(const char* path, std::string& error) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        error = std::string(path) + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        error = std::string(path) + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            error = std::string(path) + ": " + std::strerror(errno);
+            ::close(fd);
+            size = 0;
+            return false;
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+    }
+    ::close(fd);
+    return true;
+}
+
+bool Trace::next(Command& command) {
+    while (offset < size) {
+        const char* begin = data + offset;
+        const char* newline = static_cast<const char*>(std::memchr(begin, '\n', size - offset));
+        const char* end = newline ? newline : data + size;
+        offset = (end - data) + (newline ? 1 : 0);
+        ++lineNumber;
+
+        const char* p = begin;
+        while (p < end && isSpace(*p)) ++p;
+        if (p == end || *p == '#') continue;
+
+        command.line = std::string_view(begin, end - begin);
+        command.argc = -1;
+        while (p < end) {
+            const char* token = p;
+            while (p < end && !isSpace(*p)) ++p;
+            std::string_view view(token, p - token);
+            if (command.argc < 0) {
+                command.op = view;
+            } else if (command.argc < kMaxArgs) {
+                command.args[command.argc] = view;
+            }
+            ++command.argc;
+            while (p < end && isSpace(*p)) ++p;
+        }
+        return true;
+    }
+    return false;
+}
+
+uint64_t nowNanos() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Report::Report() : startNanos(0), elapsedNanos(0) {}
+
+void Report::start() { startNanos = nowNanos(); }
+void Report::stop() { elapsedNanos = nowNanos() - startNanos; }
+
+Report::OpStats& Report::statsFor(std::string_view op) {
+    for (size_t i = 0; i < ops.size(); ++i) {
+        if (ops[i].op == op) return ops[i];
+    }
+    OpStats stats;
+    stats.op = std::string(op);
+    stats.count = stats.failed = stats.totalNanos = stats.maxNanos = 0;
+    stats.histogram.assign(instrument::kBuckets, 0);
+    ops.push_back(stats);
+    return ops.back();
+}
+
+void Report::record(std::string_view op, uint64_t nanos, bool ok) {
+    OpStats& stats = statsFor(op);
+    ++stats.count;
+    if (!ok) ++stats.failed;
+    stats.totalNanos += nanos;
+    if (nanos > stats.maxNanos) stats.maxNanos = nanos;
+    ++stats.histogram[instrument::bucketFor(nanos)];
+}
+
+namespace {
+
+uint64_t quantile(const std::vector<uint64_t>& histogram, uint64_t count, double q) {
+    uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(count - 1));
+    uint64_t seen = 0;
+    for (size_t b = 0; b < histogram.size(); ++b) {
+        seen += histogram[b];
+        if (seen > rank) return instrument::bucketLowerBound(static_cast<int>(b));
+    }
+    return 0;
+}
+
+}  // namespace
+
+void Report::print(std::ostream& os) const {
+    uint64_t total = 0;
+    for (size_t i = 0; i < ops.size(); ++i) total += ops[i].count;
+    double seconds = elapsedNanos / 1e9;
+    char line[256];
+    std::snprintf(line, sizeof(line), "Replayed %llu ops in %.3f s (%.0f ops/s)\n",
+                  static_cast<unsigned long long>(total), seconds, seconds > 0 ? total / seconds : 0.0);
+    os << line;
+    os << "op                 count     failed     mean(ns)      p50(ns)      p99(ns)      max(ns)\n";
+    for (size_t i = 0; i < ops.size(); ++i) {
+        const OpStats& s = ops[i];
+        std::snprintf(line, sizeof(line), "%-12s %11llu %10llu %12.1f %12llu %12llu %12llu\n", s.op.c_str(),
+                      static_cast<unsigned long long>(s.count), static_cast<unsigned long long>(s.failed),
+                      static_cast<double>(s.totalNanos) / s.count,
+                      static_cast<unsigned long long>(quantile(s.histogram, s.count, 0.50)),
+                      static_cast<unsigned long long>(quantile(s.histogram, s.count, 0.99)),
+                      static_cast<unsigned long long>(s.maxNanos));
+        os << line;
+    }
+}
+
+}  // namespace replay
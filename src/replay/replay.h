@@ -0,0 +1,158 @@
+/*
+Headless replay of recorded operation traces. A trace is a text file with one
+command per line: an operation name followed by whitespace-separated
+arguments; blank lines and lines starting with '#' are skipped. The file is
+mmap'ed and commands are handed out as views into the mapping, so nothing is
+copied until an engine call needs a std::string.
+*/
+#ifndef REPLAY_REPLAY_H
+#define REPLAY_REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace replay {
+
+const int kMaxArgs = 8;
+
+// argc is the number of argument tokens on the line. Only the first kMaxArgs
+// are kept in args; later ones are reachable through tail(), and an executor
+// that takes a fixed number of arguments rejects them with expectArgs().
+struct Command {
+    std::string_view op;
+    std::string_view args[kMaxArgs];
+    int argc;
+    std::string_view line;
+
+    // Everything from argument i to the end of the line, for free-text fields
+    // such as names that may contain spaces.
+    std::string_view tail(int i) const;
+};
+
+bool toInt(std::string_view text, int& value);
+bool toDouble(std::string_view text, double& value);
+
+// Argument accessors for executors; each throws std::invalid_argument naming
+// the command when the argument is missing or does not parse.
+int intArg(const Command& command, int i);
+double doubleArg(const Command& command, int i);
+std::string stringArg(const Command& command, int i);
+std::string_view viewArg(const Command& command, int i);
+std::string tailArg(const Command& command, int i);
+[[noreturn]] void unknownCommand(const Command& command);
+
+// Arity checks, throwing std::invalid_argument like the accessors:
+// expectArgs requires exactly count arguments, expectTailArgs at least count
+// where the last one is free text read with tailArg().
+void expectArgs(const Command& command, int count);
+void expectTailArgs(const Command& command, int count);
+
+// Stream that formats as usual but discards the characters, so report
+// commands pay their real formatting cost without terminal output.
+class NullStream : public std::ostream {
+private:
+    class Buffer : public std::streambuf {
+    protected:
+        int_type overflow(int_type c) override { return traits_type::not_eof(c); }
+        std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+    };
+
+    Buffer buffer;
+
+public:
+    NullStream() : std::ostream(&buffer) {}
+};
+
+class Trace {
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+    size_t lineNumber;
+
+public:
+    Trace() : data(nullptr), size(0), offset(0), lineNumber(0) {}
+    ~Trace();
+
+    Trace(const Trace&) = delete;
+    Trace& operator=(const Trace&) = delete;
+
+    // Maps the file read-only. On failure error describes why.
+    bool open(const char* path, std::string& error);
+
+    // Advances to the next command; false at end of trace.
+    bool next(Command& command);
+
+    size_t getLineNumber() const { return lineNumber; }
+};
+
+// Per-operation counts and latency histograms for one replay run.
+class Report {
+private:
+    struct OpStats {
+        std::string op;
+        uint64_t count;
+        uint64_t failed;
+        uint64_t totalNanos;
+        uint64_t maxNanos;
+        std::vector<uint64_t> histogram;
+    };
+
+    std::vector<OpStats> ops;
+    uint64_t startNanos;
+    uint64_t elapsedNanos;
+
+    OpStats& statsFor(std::string_view op);
+
+public:
+    Report();
+
+    void start();
+    void stop();
+    void record(std::string_view op, uint64_t nanos, bool ok);
+
+    void print(std::ostream& os) const;
+};
+
+uint64_t nowNanos();
+
+// Runs every command of the trace through execute, which returns false when
+// the engine rejected the operation and throws std::invalid_argument when
+// the command is malformed. Prints the report to os; returns the process exit
+// code (non-zero if the trace could not be read or had a malformed command).
+template <typename Execute>
+int run(const char* path, Execute execute, std::ostream& os = std::cout) {
+    Trace trace;
+    std::string error;
+    if (!trace.open(path, error)) {
+        std::cerr << "replay: " << error << "\n";
+        return 1;
+    }
+    Report report;
+    Command command;
+    report.start();
+    while (trace.next(command)) {
+        uint64_t begin = nowNanos();
+        bool ok;
+        try {
+            ok = execute(command);
+        } catch (const std::exception& e) {
+            std::cerr << "replay: line " << trace.getLineNumber() << ": " << e.what() << "\n";
+            return 1;
+        }
+        report.record(command.op, nowNanos() - begin, ok);
+    }
+    report.stop();
+    report.print(os);
+    return 0;
+}
+
+}  // namespace replay
+
+#endif
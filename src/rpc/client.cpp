@@ -0,0 +1,98 @@
+#include "rpc/client.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace rpc {
+
+Client::~Client() {
+    if (fd >= 0) close(fd);
+}
+
+bool Client::connectUnix(const std::string& path, std::string& error) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        error = "socket path too long: " + path;
+        return false;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        error = path + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+bool Client::connectTcp(int port, std::string& error) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        error = std::string("connect: ") + std::strerror(errno);
+        return false;
+    }
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return true;
+}
+
+void Client::send(uint32_t id, Op op, const std::string& body) {
+    Writer writer(output);
+    writer.beginFrame(id, static_cast<uint8_t>(op));
+    output.append(body);
+    writer.endFrame();
+}
+
+bool Client::flush() {
+    size_t written = 0;
+    while (written < output.size()) {
+        ssize_t n = ::send(fd, output.data() + written, output.size() - written, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        written += static_cast<size_t>(n);
+    }
+    output.clear();
+    return true;
+}
+
+bool Client::receive(Response& response) {
+    while (true) {
+        size_t available = input.size() - inputOffset;
+        if (available >= 4) {
+            uint32_t length = peekLength(input.data() + inputOffset);
+            if (length < kHeaderSize - 4 || length > kMaxFrame) return false;
+            if (available - 4 >= length) {
+                const char* frame = input.data() + inputOffset;
+                response.id = peekLength(frame + 4);
+                response.reply = static_cast<Reply>(frame[8]);
+                response.body.assign(frame + kHeaderSize, length - (kHeaderSize - 4));
+                inputOffset += 4 + length;
+                return true;
+            }
+        }
+        if (inputOffset > 0) {
+            input.erase(0, inputOffset);
+            inputOffset = 0;
+        }
+        char buffer[65536];
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        input.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+}  // namespace rpc
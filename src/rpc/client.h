@@ -0,0 +1,50 @@
+/*
+Blocking client for the local RPC server. Requests are buffered by send()
+and written by flush(), so a caller can pipeline any number of requests and
+then collect the responses with receive().
+*/
+#ifndef RPC_CLIENT_H
+#define RPC_CLIENT_H
+
+#include <cstdint>
+#include <string>
+
+#include "rpc/protocol.h"
+
+namespace rpc {
+
+struct Response {
+    uint32_t id;
+    Reply reply;
+    std::string body;
+};
+
+class Client {
+private:
+    int fd;
+    std::string output;
+    std::string input;
+    size_t inputOffset;
+
+public:
+    Client() : fd(-1), inputOffset(0) {}
+    ~Client();
+
+    Client(const Client&) = delete;
+    Client& operator=(const Client&) = delete;
+
+    bool connectUnix(const std::string& path, std::string& error);
+    bool connectTcp(int port, std::string& error);
+
+    // Appends a request frame; body holds the op's fields (see protocol.h),
+    // typically built with a Writer over a scratch string.
+    void send(uint32_t id, Op op, const std::string& body);
+    bool flush();
+
+    // Blocks until a full response frame is available.
+    bool receive(Response& response);
+};
+
+}  // namespace rpc
+
+#endif
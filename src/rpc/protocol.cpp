@@ -0,0 +1,83 @@
+#include "rpc/protocol.h"
+
+#include <cstring>
+
+namespace rpc {
+
+void Writer::beginFrame(uint32_t id, uint8_t code) {
+    frameStart = out.size();
+    putU32(0);
+    putU32(id);
+    putU8(code);
+}
+
+void Writer::endFrame() {
+    uint32_t length = static_cast<uint32_t>(out.size() - frameStart - 4);
+    for (int i = 0; i < 4; ++i) {
+        out[frameStart + i] = static_cast<char>((length >> (8 * i)) & 0xff);
+    }
+}
+
+void Writer::putU32(uint32_t value) {
+    char bytes[4];
+    for (int i = 0; i < 4; ++i) bytes[i] = static_cast<char>((value >> (8 * i)) & 0xff);
+    out.append(bytes, 4);
+}
+
+void Writer::putF64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    putU32(static_cast<uint32_t>(bits));
+    putU32(static_cast<uint32_t>(bits >> 32));
+}
+
+void Writer::putString(const std::string& value) {
+    putU32(static_cast<uint32_t>(value.size()));
+    out.append(value);
+}
+
+uint8_t Reader::getU8() {
+    if (!ok || end - p < 1) {
+        ok = false;
+        return 0;
+    }
+    return static_cast<uint8_t>(*p++);
+}
+
+uint32_t Reader::getU32() {
+    if (!ok || end - p < 4) {
+        ok = false;
+        return 0;
+    }
+    uint32_t value = peekLength(p);
+    p += 4;
+    return value;
+}
+
+double Reader::getF64() {
+    uint64_t low = getU32();
+    uint64_t high = getU32();
+    uint64_t bits = low | (high << 32);
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string Reader::getString() {
+    uint32_t size = getU32();
+    if (!ok || static_cast<uint32_t>(end - p) < size) {
+        ok = false;
+        return std::string();
+    }
+    std::string value(p, size);
+    p += size;
+    return value;
+}
+
+uint32_t peekLength(const char* data) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+}  // namespace rpc
@@ -0,0 +1,88 @@
+/*
+Wire format of the local RPC server. Every message is a frame:
+
+    u32 length | u32 request id | u8 op or status | body
+
+where length counts the bytes after itself. Integers are little-endian,
+strings are a u32 byte count followed by the bytes. Clients may send many
+frames without waiting; each response echoes the request id of its request.
+*/
+#ifndef RPC_PROTOCOL_H
+#define RPC_PROTOCOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace rpc {
+
+const uint32_t kMaxFrame = 1 << 20;
+const size_t kHeaderSize = 9;
+
+enum class Op : uint8_t {
+    AddStudent = 1,       // i32 roll, str name
+    AddSubject = 2,       // i32 code, str name
+    Enroll = 3,           // i32 roll, i32 code
+    StudentSubjects = 4,  // i32 roll -> u32 n, n x (i32 code, str name)
+    SubjectStudents = 5,  // i32 code -> u32 n, n x (i32 roll, str name)
+    AddBook = 6,          // str bookId, i32 serial, str title, str author, str publisher, f64 price
+    AddMember = 7,        // str memberId, str name, str email, str address, u8 isFaculty
+    IssueBook = 8,        // str memberId, str bookId -> i32 serial
+    ReturnBook = 9        // str memberId, str bookId, i32 serial
+};
+
+// Response status byte. Rejected bodies carry the engine's reason: a u8
+// circulation::Status for library ops, nothing for enrollment ops. A roster
+// whose response would exceed kMaxFrame is also Rejected.
+enum class Reply : uint8_t {
+    Ok = 0,
+    Rejected = 1,
+    BadRequest = 2
+};
+
+class Writer {
+private:
+    std::string& out;
+    size_t frameStart;
+
+public:
+    explicit Writer(std::string& out) : out(out), frameStart(0) {}
+
+    // Starts a frame; its length is patched in by endFrame.
+    void beginFrame(uint32_t id, uint8_t code);
+    void endFrame();
+
+    void putU8(uint8_t value) { out.push_back(static_cast<char>(value)); }
+    void putU32(uint32_t value);
+    void putI32(int32_t value) { putU32(static_cast<uint32_t>(value)); }
+    void putF64(double value);
+    void putString(const std::string& value);
+};
+
+class Reader {
+private:
+    const char* p;
+    const char* end;
+    bool ok;
+
+public:
+    Reader(const char* data, size_t size) : p(data), end(data + size), ok(true) {}
+
+    // Each getter returns a zero value and latches failure when the body is
+    // too short; check good() after reading all fields.
+    uint8_t getU8();
+    uint32_t getU32();
+    int32_t getI32() { return static_cast<int32_t>(getU32()); }
+    double getF64();
+    std::string getString();
+
+    bool good() const { return ok; }
+    bool atEnd() const { return p == end; }
+};
+
+// Reads the length prefix of a buffered frame.
+uint32_t peekLength(const char* data);
+
+}  // namespace rpc
+
+#endif
@@ -0,0 +1,561 @@
+#include "rpc/server.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "instrument/instrument.h"
+#include "rpc/protocol.h"
+
+namespace rpc {
+
+struct Server::Connection {
+    int fd;
+    bool closed;
+    bool readClosed;  // the peer has shut down its sending side
+    uint32_t events;  // what epoll is watching for
+    std::string input;
+    std::string output;
+
+    // Shared with the workers.
+    std::mutex mutex;
+    std::deque<Frame> pending;
+    size_t pendingBytes;
+    std::string outbox;
+    bool busy;
+
+    explicit Connection(int fd)
+        : fd(fd), closed(false), readClosed(false), events(EPOLLIN), pendingBytes(0), busy(false) {}
+};
+
+namespace {
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+std::string systemError(const char* what) {
+    return std::string(what) + ": " + std::strerror(errno);
+}
+
+enum class Lock { None, Library, EnrollmentShared, EnrollmentExclusive };
+
+Lock lockFor(uint8_t op) {
+    switch (static_cast<Op>(op)) {
+        case Op::AddBook:
+        case Op::AddMember:
+        case Op::IssueBook:
+        case Op::ReturnBook:
+            return Lock::Library;
+        case Op::StudentSubjects:
+        case Op::SubjectStudents:
+            return Lock::EnrollmentShared;
+        case Op::AddStudent:
+        case Op::AddSubject:
+        case Op::Enroll:
+            return Lock::EnrollmentExclusive;
+    }
+    return Lock::None;
+}
+
+// A request is well formed when every field decoded and nothing trails
+// them. Each op checks this before it touches an engine, so a malformed
+// frame never changes state.
+bool decoded(const Reader& reader) {
+    return reader.good() && reader.atEnd();
+}
+
+}  // namespace
+
+Server::Server(circulation::Library& library, enrollment::StudentList& studentList, enrollment::SubjectList& subjectList,
+               const ServerOptions& options)
+    : library(library), studentList(studentList), subjectList(subjectList), options(options),
+      listenFd(-1), epollFd(-1), wakeFd(-1), port(0), stopping(false) {}
+
+Server::~Server() {
+    if (listenFd >= 0) close(listenFd);
+    if (epollFd >= 0) close(epollFd);
+    if (wakeFd >= 0) close(wakeFd);
+    if (!unixPath.empty()) unlink(unixPath.c_str());
+}
+
+bool Server::listenUnix(const std::string& path, std::string& error) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        error = "socket path too long: " + path;
+        return false;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        error = systemError("socket");
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, SOMAXCONN) != 0) {
+        error = systemError(path.c_str());
+        return false;
+    }
+    unixPath = path;
+    return setupEpoll(error);
+}
+
+bool Server::listenTcp(int requestedPort, std::string& error) {
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(requestedPort));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) {
+        error = systemError("socket");
+        return false;
+    }
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listenFd, SOMAXCONN) != 0) {
+        error = systemError("bind");
+        return false;
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+    port = ntohs(address.sin_port);
+    return setupEpoll(error);
+}
+
+bool Server::setupEpoll(std::string& error) {
+    setNonBlocking(listenFd);
+    epollFd = epoll_create1(0);
+    wakeFd = eventfd(0, EFD_NONBLOCK);
+    if (epollFd < 0 || wakeFd < 0) {
+        error = systemError("epoll");
+        return false;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listenFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+    event.data.fd = wakeFd;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+    return true;
+}
+
+void Server::run() {
+    for (int i = 0; i < options.workers; ++i) {
+        workers.push_back(std::thread(&Server::workerLoop, this));
+    }
+
+    epoll_event events[64];
+    while (!stopping.load()) {
+        int n = epoll_wait(epollFd, events, 64, -1);
+        if (n < 0 && errno != EINTR) break;
+        for (int i = 0; i < n; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listenFd) {
+                acceptConnections();
+            } else if (fd == wakeFd) {
+                uint64_t value;
+                while (read(wakeFd, &value, sizeof(value)) > 0) {
+                }
+                flushReady();
+            } else {
+                std::map<int, std::shared_ptr<Connection>>::iterator it = connections.find(fd);
+                if (it == connections.end()) continue;
+                std::shared_ptr<Connection> connection = it->second;
+                if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                    closeConnection(connection);
+                    continue;
+                }
+                if (events[i].events & EPOLLIN) readConnection(connection);
+                if (!connection->closed && (events[i].events & EPOLLOUT)) writeConnection(connection);
+            }
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queueReady.notify_all();
+    }
+    for (size_t i = 0; i < workers.size(); ++i) workers[i].join();
+    workers.clear();
+    while (!connections.empty()) closeConnection(connections.begin()->second);
+}
+
+void Server::stop() {
+    stopping.store(true);
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0) {
+    }
+}
+
+void Server::acceptConnections() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) return;
+        setNonBlocking(fd);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        std::shared_ptr<Connection> connection(new Connection(fd));
+        connections[fd] = connection;
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+}
+
+void Server::readConnection(const std::shared_ptr<Connection>& connection) {
+    char buffer[65536];
+    while (queuedBytes(connection) < options.maxQueued) {
+        ssize_t n = recv(connection->fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            connection->input.append(buffer, static_cast<size_t>(n));
+            if (!parseFrames(connection)) {
+                closeConnection(connection);
+                return;
+            }
+            continue;
+        }
+        if (n == 0) {
+            // Half-close: answer what was already sent, then close.
+            connection->readClosed = true;
+            break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        closeConnection(connection);
+        return;
+    }
+    updateEvents(connection);
+}
+
+bool Server::parseFrames(const std::shared_ptr<Connection>& connection) {
+    std::vector<Frame> frames;
+    size_t offset = 0;
+    const std::string& input = connection->input;
+    while (input.size() - offset >= 4) {
+        uint32_t length = peekLength(input.data() + offset);
+        if (length < kHeaderSize - 4 || length > kMaxFrame) return false;
+        if (input.size() - offset - 4 < length) break;
+        Frame frame;
+        frame.id = peekLength(input.data() + offset + 4);
+        frame.op = static_cast<uint8_t>(input[offset + 8]);
+        frame.body.assign(input, offset + kHeaderSize, length - (kHeaderSize - 4));
+        frames.push_back(std::move(frame));
+        offset += 4 + length;
+    }
+    connection->input.erase(0, offset);
+    if (frames.empty()) return true;
+
+    bool idle;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        for (size_t i = 0; i < frames.size(); ++i) {
+            connection->pendingBytes += kHeaderSize + frames[i].body.size();
+            connection->pending.push_back(std::move(frames[i]));
+        }
+        idle = !connection->busy;
+        connection->busy = true;
+    }
+    if (idle) schedule(connection);
+    return true;
+}
+
+size_t Server::queuedBytes(const std::shared_ptr<Connection>& connection) {
+    std::lock_guard<std::mutex> lock(connection->mutex);
+    return connection->pendingBytes + connection->outbox.size() + connection->output.size();
+}
+
+void Server::updateEvents(const std::shared_ptr<Connection>& connection) {
+    if (connection->closed) return;
+    size_t queued;
+    bool idle;
+    {
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        queued = connection->pendingBytes + connection->outbox.size() + connection->output.size();
+        idle = !connection->busy;
+    }
+    if (connection->readClosed && idle && queued == 0) {
+        closeConnection(connection);
+        return;
+    }
+    // Reads pause while too much is queued and resume once responses drain.
+    uint32_t events = 0;
+    if (!connection->readClosed && queued < options.maxQueued) events |= EPOLLIN;
+    if (!connection->output.empty()) events |= EPOLLOUT;
+    if (events != connection->events) {
+        connection->events = events;
+        epoll_event event;
+        event.events = events;
+        event.data.fd = connection->fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, connection->fd, &event);
+    }
+}
+
+void Server::writeConnection(const std::shared_ptr<Connection>& connection) {
+    while (!connection->output.empty()) {
+        ssize_t n = send(connection->fd, connection->output.data(), connection->output.size(), MSG_NOSIGNAL);
+        if (n > 0) {
+            connection->output.erase(0, static_cast<size_t>(n));
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (n < 0 && errno == EINTR) continue;
+        closeConnection(connection);
+        return;
+    }
+    updateEvents(connection);
+}
+
+void Server::closeConnection(const std::shared_ptr<Connection>& connection) {
+    if (connection->closed) return;
+    connection->closed = true;
+    int fd = connection->fd;
+    epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    // Last: connection may refer to the map entry itself.
+    connections.erase(fd);
+}
+
+void Server::flushReady() {
+    std::vector<std::shared_ptr<Connection>> batch;
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        batch.swap(ready);
+    }
+    for (size_t i = 0; i < batch.size(); ++i) {
+        std::shared_ptr<Connection>& connection = batch[i];
+        if (connection->closed) continue;
+        {
+            std::lock_guard<std::mutex> lock(connection->mutex);
+            connection->output.append(connection->outbox);
+            connection->outbox.clear();
+        }
+        writeConnection(connection);
+    }
+}
+
+void Server::schedule(const std::shared_ptr<Connection>& connection) {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queue.push_back(connection);
+    queueReady.notify_one();
+}
+
+void Server::workerLoop() {
+    std::vector<Frame> batch;
+    std::string out;
+    while (true) {
+        std::shared_ptr<Connection> connection;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [this] { return stopping.load() || !queue.empty(); });
+            if (stopping.load()) return;
+            connection = queue.front();
+            queue.pop_front();
+        }
+
+        batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(connection->mutex);
+            while (!connection->pending.empty() && batch.size() < options.maxBatch) {
+                connection->pendingBytes -= kHeaderSize + connection->pending.front().body.size();
+                batch.push_back(std::move(connection->pending.front()));
+                connection->pending.pop_front();
+            }
+        }
+
+        out.clear();
+        executeBatch(batch, out);
+
+        bool more;
+        {
+            std::lock_guard<std::mutex> lock(connection->mutex);
+            connection->outbox.append(out);
+            more = !connection->pending.empty();
+            connection->busy = more;
+        }
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            ready.push_back(connection);
+        }
+        uint64_t one = 1;
+        if (write(wakeFd, &one, sizeof(one)) < 0) {
+        }
+        // Requeue rather than drain so one chatty connection cannot starve the others.
+        if (more) schedule(connection);
+    }
+}
+
+void Server::executeBatch(std::vector<Frame>& batch, std::string& out) {
+    INSTRUMENT_SCOPE("rpc.batch");
+    Writer writer(out);
+    Lock held = Lock::None;
+    std::unique_lock<std::mutex> libraryLock(libraryMutex, std::defer_lock);
+    std::shared_lock<std::shared_mutex> enrollmentRead(enrollmentMutex, std::defer_lock);
+    std::unique_lock<std::shared_mutex> enrollmentWrite(enrollmentMutex, std::defer_lock);
+
+    for (size_t i = 0; i < batch.size(); ++i) {
+        const Frame& frame = batch[i];
+        Lock needed = lockFor(frame.op);
+        if (needed != held) {
+            if (libraryLock.owns_lock()) libraryLock.unlock();
+            if (enrollmentRead.owns_lock()) enrollmentRead.unlock();
+            if (enrollmentWrite.owns_lock()) enrollmentWrite.unlock();
+            if (needed == Lock::Library) libraryLock.lock();
+            if (needed == Lock::EnrollmentShared) enrollmentRead.lock();
+            if (needed == Lock::EnrollmentExclusive) enrollmentWrite.lock();
+            held = needed;
+        }
+
+        Reader reader(frame.body.data(), frame.body.size());
+        size_t frameStart = out.size();
+        writer.beginFrame(frame.id, static_cast<uint8_t>(Reply::Ok));
+        Reply reply = Reply::Ok;
+        switch (static_cast<Op>(frame.op)) {
+            case Op::AddStudent: {
+                int roll = reader.getI32();
+                std::string name = reader.getString();
+                if (!decoded(reader)) break;
+                if (!studentList.addStudent(roll, name)) reply = Reply::Rejected;
+                break;
+            }
+            case Op::AddSubject: {
+                int code = reader.getI32();
+                std::string name = reader.getString();
+                if (!decoded(reader)) break;
+                if (!subjectList.addSubject(code, name)) reply = Reply::Rejected;
+                break;
+            }
+            case Op::Enroll: {
+                int roll = reader.getI32();
+                int code = reader.getI32();
+                if (!decoded(reader)) break;
+                enrollment::Student* student = studentList.findStudentByRoll(roll);
+                enrollment::Subject* subject = subjectList.findSubjectByCode(code);
+                if (student && subject) {
+                    student->enrollSubject(subject);
+                } else {
+                    reply = Reply::Rejected;
+                }
+                break;
+            }
+            case Op::StudentSubjects: {
+                int roll = reader.getI32();
+                if (!decoded(reader)) break;
+                enrollment::Student* student = studentList.findStudentByRoll(roll);
+                if (!student) {
+                    reply = Reply::Rejected;
+                    break;
+                }
+                const mvcc::AppendLog<enrollment::Subject*>& subjects = student->getEnrolledSubjects();
+                writer.putU32(static_cast<uint32_t>(subjects.size()));
+                subjects.forEach([&](const enrollment::Subject* subject) {
+                    writer.putI32(subject->getCode());
+                    writer.putString(subject->getName());
+                });
+                break;
+            }
+            case Op::SubjectStudents: {
+                int code = reader.getI32();
+                if (!decoded(reader)) break;
+                enrollment::Subject* subject = subjectList.findSubjectByCode(code);
+                if (!subject) {
+                    reply = Reply::Rejected;
+                    break;
+                }
+                const mvcc::AppendLog<enrollment::Student*>& students = subject->getEnrolledStudents();
+                writer.putU32(static_cast<uint32_t>(students.size()));
+                students.forEach([&](const enrollment::Student* student) {
+                    writer.putI32(student->getRoll());
+                    writer.putString(student->getName());
+                });
+                break;
+            }
+            case Op::AddBook: {
+                std::string bookId = reader.getString();
+                int serial = reader.getI32();
+                std::string title = reader.getString();
+                std::string author = reader.getString();
+                std::string publisher = reader.getString();
+                double price = reader.getF64();
+                if (!decoded(reader)) break;
+                circulation::Status status = library.addBook(bookId, serial, title, author, publisher, price);
+                if (status != circulation::Status::Ok) {
+                    reply = Reply::Rejected;
+                    writer.putU8(static_cast<uint8_t>(status));
+                }
+                break;
+            }
+            case Op::AddMember: {
+                std::string memberId = reader.getString();
+                std::string name = reader.getString();
+                std::string email = reader.getString();
+                std::string address = reader.getString();
+                bool isFaculty = reader.getU8() != 0;
+                if (!decoded(reader)) break;
+                circulation::Status status = library.addMember(memberId, name, email, address, isFaculty);
+                if (status != circulation::Status::Ok) {
+                    reply = Reply::Rejected;
+                    writer.putU8(static_cast<uint8_t>(status));
+                }
+                break;
+            }
+            case Op::IssueBook: {
+                std::string memberId = reader.getString();
+                std::string bookId = reader.getString();
+                if (!decoded(reader)) break;
+                int serial = 0;
+                circulation::Status status = library.issueBook(memberId, bookId, &serial);
+                if (status == circulation::Status::Ok) {
+                    writer.putI32(serial);
+                } else {
+                    reply = Reply::Rejected;
+                    writer.putU8(static_cast<uint8_t>(status));
+                }
+                break;
+            }
+            case Op::ReturnBook: {
+                std::string memberId = reader.getString();
+                std::string bookId = reader.getString();
+                int serial = reader.getI32();
+                if (!decoded(reader)) break;
+                circulation::Status status = library.returnBook(memberId, bookId, serial);
+                if (status != circulation::Status::Ok) {
+                    reply = Reply::Rejected;
+                    writer.putU8(static_cast<uint8_t>(status));
+                }
+                break;
+            }
+            default:
+                reply = Reply::BadRequest;
+                break;
+        }
+        if (!decoded(reader) || reply == Reply::BadRequest) {
+            reply = Reply::BadRequest;
+            out.resize(frameStart);
+            writer.beginFrame(frame.id, static_cast<uint8_t>(reply));
+        } else if (out.size() - frameStart - 4 > kMaxFrame) {
+            // A roster too long for one frame; clients reject such frames.
+            reply = Reply::Rejected;
+            out.resize(frameStart);
+            writer.beginFrame(frame.id, static_cast<uint8_t>(reply));
+        } else {
+            out[frameStart + 8] = static_cast<char>(reply);
+        }
+        writer.endFrame();
+    }
+}
+
+}  // namespace rpc
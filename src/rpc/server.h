@@ -0,0 +1,108 @@
+/*
+Local RPC server for the library and enrollment engines. One thread runs an
+epoll loop that accepts connections, reads frames and writes responses; a
+worker pool executes requests. Frames that arrive together on a connection
+are executed as one batch under a single engine lock acquisition, and each
+connection's batches run in arrival order while different connections
+proceed in parallel.
+*/
+#ifndef RPC_SERVER_H
+#define RPC_SERVER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "circulation/library.h"
+#include "enrollment/enrollment.h"
+
+namespace rpc {
+
+struct ServerOptions {
+    int workers;
+    size_t maxBatch;
+    // A connection stops being read while this many bytes of its requests
+    // and responses are queued, and resumes once they drain.
+    size_t maxQueued;
+
+    ServerOptions() : workers(4), maxBatch(64), maxQueued(4 << 20) {}
+};
+
+class Server {
+public:
+    struct Frame {
+        uint32_t id;
+        uint8_t op;
+        std::string body;
+    };
+
+    struct Connection;
+
+    Server(circulation::Library& library, enrollment::StudentList& studentList, enrollment::SubjectList& subjectList,
+           const ServerOptions& options = ServerOptions());
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Bind before run(). The Unix socket path is unlinked first; TCP binds
+    // 127.0.0.1 (port 0 picks a free port, see getPort).
+    bool listenUnix(const std::string& path, std::string& error);
+    bool listenTcp(int port, std::string& error);
+    int getPort() const { return port; }
+
+    // Serves until stop() is called from any thread.
+    void run();
+    void stop();
+
+private:
+    circulation::Library& library;
+    enrollment::StudentList& studentList;
+    enrollment::SubjectList& subjectList;
+    ServerOptions options;
+
+    std::mutex libraryMutex;
+    std::shared_mutex enrollmentMutex;
+
+    int listenFd;
+    int epollFd;
+    int wakeFd;
+    int port;
+    std::string unixPath;
+    std::atomic<bool> stopping;
+
+    std::map<int, std::shared_ptr<Connection>> connections;
+
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<std::shared_ptr<Connection>> queue;
+    std::vector<std::thread> workers;
+
+    std::mutex readyMutex;
+    std::vector<std::shared_ptr<Connection>> ready;
+
+    bool setupEpoll(std::string& error);
+    void acceptConnections();
+    void readConnection(const std::shared_ptr<Connection>& connection);
+    bool parseFrames(const std::shared_ptr<Connection>& connection);
+    size_t queuedBytes(const std::shared_ptr<Connection>& connection);
+    void updateEvents(const std::shared_ptr<Connection>& connection);
+    void writeConnection(const std::shared_ptr<Connection>& connection);
+    void closeConnection(const std::shared_ptr<Connection>& connection);
+    void flushReady();
+
+    void schedule(const std::shared_ptr<Connection>& connection);
+    void workerLoop();
+    void executeBatch(std::vector<Frame>& batch, std::string& out);
+};
+
+}  // namespace rpc
+
+#endif
@@ -0,0 +1,254 @@
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "cricket/cricket.h"
+
+using cricket::BirthDateIndex;
+using cricket::Bowler;
+using cricket::Cricketer;
+using cricket::Date;
+using cricket::DeltaVarintColumn;
+using cricket::GorillaColumn;
+using cricket::SeasonHistory;
+
+namespace {
+
+uint64_t bitsOf(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+Date dateOf(const char* text) {
+    Date date;
+    EXPECT_TRUE(Date::parse(text, date)) << text;
+    return date;
+}
+
+bool parses(const char* text) {
+    Date date;
+    return Date::parse(text, date);
+}
+
+std::vector<std::string> namesOf(const std::vector<Cricketer*>& players) {
+    std::vector<std::string> names;
+    for (Cricketer* player : players) names.push_back(player->get_name());
+    return names;
+}
+
+double fromBits(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void expectDeltaRoundTrip(const std::vector<int64_t>& values) {
+    DeltaVarintColumn column;
+    for (int64_t value : values) column.append(value);
+    column.compact();
+    std::vector<double> decoded;
+    column.decode(decoded);
+    ASSERT_EQ(decoded.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(bitsOf(decoded[i]), bitsOf(static_cast<double>(values[i]))) << "index " << i;
+    }
+}
+
+void expectGorillaRoundTrip(const std::vector<double>& values) {
+    GorillaColumn column;
+    for (double value : values) column.append(value);
+    column.compact();
+    std::vector<double> decoded;
+    column.decode(decoded);
+    ASSERT_EQ(decoded.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(bitsOf(decoded[i]), bitsOf(values[i])) << "index " << i;
+    }
+}
+
+}  // namespace
+
+TEST(DeltaVarintColumn, EmptyColumnDecodesToNothing) {
+    expectDeltaRoundTrip({});
+}
+
+TEST(DeltaVarintColumn, NegativeDeltasAndRepeats) {
+    expectDeltaRoundTrip({0, 0, 5, 3, -7, -7, -7, 120, 0, -1, 1, -128, 127, 64, -65});
+}
+
+TEST(DeltaVarintColumn, LargeJumps) {
+    const int64_t big = int64_t(1) << 53;
+    expectDeltaRoundTrip({big, -big, big, 0, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()});
+}
+
+TEST(DeltaVarintColumn, RandomWalk) {
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int64_t> step(-100000, 100000);
+    std::vector<int64_t> values;
+    int64_t value = 0;
+    for (int i = 0; i < 5000; ++i) {
+        value += step(rng);
+        values.push_back(value);
+    }
+    expectDeltaRoundTrip(values);
+}
+
+TEST(GorillaColumn, SpecialValues) {
+    const double inf = std::numeric_limits<double>::infinity();
+    expectGorillaRoundTrip({0.0, -0.0, 0.0, -0.0, -0.0, inf, -inf, std::numeric_limits<double>::quiet_NaN(),
+                            fromBits(0x7ff0000000000001ULL), fromBits(0xfff8000000000123ULL),
+                            std::numeric_limits<double>::denorm_min(), std::numeric_limits<double>::min(),
+                            std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), 1.0});
+}
+
+TEST(GorillaColumn, RepeatedValues) {
+    expectGorillaRoundTrip(std::vector<double>(100, 6.25));
+    expectGorillaRoundTrip({1.0, 1.0, 2.0, 2.0, 2.0, 1.0, 1.0});
+}
+
+TEST(GorillaColumn, EconomyLikeValues) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> conceded(12, 48);
+    std::vector<double> values;
+    for (int i = 0; i < 5000; ++i) values.push_back(conceded(rng) / 4.0);
+    expectGorillaRoundTrip(values);
+}
+
+TEST(GorillaColumn, ArbitraryBitPatterns) {
+    // Covers every leading/trailing window, including a full 64-bit XOR.
+    std::mt19937_64 rng(3);
+    std::vector<double> values;
+    for (int i = 0; i < 5000; ++i) {
+        uint64_t bits = rng();
+        if (i % 3 == 0) bits &= ~0ULL << (i % 64);
+        values.push_back(fromBits(bits));
+    }
+    values.push_back(fromBits(~bitsOf(values.back())));
+    expectGorillaRoundTrip(values);
+}
+
+TEST(SeasonHistory, MemoryIncludesTheObject) {
+    SeasonHistory history;
+    EXPECT_EQ(history.memory_bytes(), sizeof(SeasonHistory));
+    for (int m = 0; m < 40; ++m) history.record(m, m % 3, 6.5);
+    history.compact();
+    EXPECT_GT(history.memory_bytes(), sizeof(SeasonHistory));
+}
+
+TEST(SeasonHistory, FormMatchesTheRecordedMatches) {
+    SeasonHistory history;
+    EXPECT_EQ(history.recent_average_score(5), 0.0);
+    std::vector<double> runs, economy;
+    for (int m = 0; m < 12; ++m) {
+        runs.push_back(m * 7 % 50);
+        economy.push_back((12 + m * 5 % 37) / 4.0);
+        history.record(m * 7 % 50, m % 3, economy.back());
+    }
+    EXPECT_DOUBLE_EQ(history.recent_average_score(3), (runs[9] + runs[10] + runs[11]) / 3);
+    EXPECT_DOUBLE_EQ(history.recent_economy(3), (economy[9] + economy[10] + economy[11]) / 3);
+    EXPECT_DOUBLE_EQ(history.recent_wickets(20), 1.0);
+
+    // The buffer is reused, so a stale longer curve must not leak through.
+    std::vector<double> curve(100, -1.0);
+    history.average_score_curve(4, curve);
+    ASSERT_EQ(curve.size(), runs.size());
+    for (size_t i = 0; i < runs.size(); ++i) {
+        size_t begin = i >= 3 ? i - 3 : 0;
+        double sum = 0.0;
+        for (size_t j = begin; j <= i; ++j) sum += runs[j];
+        EXPECT_DOUBLE_EQ(curve[i], sum / (i + 1 - begin)) << "match " << i;
+    }
+}
+
+TEST(Date, ParsesLeapDays) {
+    EXPECT_TRUE(parses("2000-02-29"));
+    EXPECT_TRUE(parses("2024-02-29"));
+    EXPECT_FALSE(parses("1900-02-29"));
+    EXPECT_FALSE(parses("2023-02-29"));
+    EXPECT_FALSE(parses("2024-02-30"));
+}
+
+TEST(Date, RejectsMonthAndDayOutOfRange) {
+    EXPECT_TRUE(parses("2023-01-31"));
+    EXPECT_TRUE(parses("2023-04-30"));
+    EXPECT_TRUE(parses("2023-12-31"));
+    EXPECT_FALSE(parses("2023-04-31"));
+    EXPECT_FALSE(parses("2023-00-10"));
+    EXPECT_FALSE(parses("2023-13-10"));
+    EXPECT_FALSE(parses("2023-05-00"));
+    EXPECT_FALSE(parses("2023-05-32"));
+}
+
+TEST(Date, RejectsMalformedText) {
+    EXPECT_FALSE(parses(""));
+    EXPECT_FALSE(parses("2023-1-01"));
+    EXPECT_FALSE(parses("2023/01/01"));
+    EXPECT_FALSE(parses("2023-01-1x"));
+    EXPECT_FALSE(parses("2023-01-011"));
+}
+
+TEST(Date, RoundTripsAndOrders) {
+    EXPECT_EQ(dateOf("1970-01-01").day_number(), 0);
+    EXPECT_EQ(dateOf("2024-02-29").to_string(), "2024-02-29");
+    EXPECT_EQ(dateOf("2024-02-28").next_day().to_string(), "2024-02-29");
+    EXPECT_EQ(dateOf("2023-12-31").next_day().to_string(), "2024-01-01");
+    EXPECT_LT(dateOf("1999-12-31").day_number(), dateOf("2000-01-01").day_number());
+    EXPECT_EQ(dateOf("2024-02-29").years_before(1).to_string(), "2023-02-28");
+}
+
+class AgeBracket : public ::testing::Test {
+protected:
+    std::vector<std::unique_ptr<Bowler>> players;
+    BirthDateIndex index;
+
+    Bowler* add(const char* name, const char* born) {
+        players.emplace_back(new Bowler(name, dateOf(born), 0, 0, 0.0));
+        index.add(players.back().get());
+        return players.back().get();
+    }
+};
+
+TEST_F(AgeBracket, BoundariesFallOnTheBirthday) {
+    add("turns18today", "2006-06-15");
+    add("turns18tomorrow", "2006-06-16");
+    add("turns21tomorrow", "2003-06-16");
+    add("turned21today", "2003-06-15");
+    EXPECT_EQ(namesOf(index.aged_between(dateOf("2024-06-15"), 18, 20)),
+              (std::vector<std::string>{"turns21tomorrow", "turns18today"}));
+}
+
+TEST_F(AgeBracket, LeapDayBirthdayCountsFromTheFirstOfMarch) {
+    add("leapling", "2004-02-29");
+    EXPECT_TRUE(index.aged_between(dateOf("2022-02-28"), 18, 18).empty());
+    EXPECT_EQ(index.aged_between(dateOf("2022-03-01"), 18, 18).size(), 1u);
+}
+
+TEST_F(AgeBracket, BornBetweenIsInclusiveAndKeepsInsertionOrderForTies) {
+    add("first", "2000-01-01");
+    add("second", "2000-01-01");
+    index.born_between(dateOf("1990-01-01"), dateOf("2010-01-01"));
+    add("third", "2000-01-01");
+    add("earlier", "1999-12-31");
+    EXPECT_EQ(namesOf(index.born_between(dateOf("1999-12-31"), dateOf("2000-01-01"))),
+              (std::vector<std::string>{"earlier", "first", "second", "third"}));
+    EXPECT_TRUE(index.born_between(dateOf("2000-01-02"), dateOf("2000-12-31")).empty());
+}
+
+TEST_F(AgeBracket, RemovedPlayersAreNotReported) {
+    Bowler* replaced = add("replaced", "2000-05-05");
+    index.born_between(dateOf("1990-01-01"), dateOf("2010-01-01"));
+    Bowler* pending = add("pending", "2001-05-05");
+    add("kept", "2002-05-05");
+    EXPECT_TRUE(index.remove(replaced));
+    EXPECT_TRUE(index.remove(pending));
+    EXPECT_FALSE(index.remove(replaced));
+    EXPECT_EQ(index.size(), 1u);
+    EXPECT_EQ(namesOf(index.born_between(dateOf("1990-01-01"), dateOf("2010-01-01"))), (std::vector<std::string>{"kept"}));
+}
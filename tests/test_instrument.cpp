@@ -0,0 +1,65 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "instrument/instrument.h"
+
+namespace {
+
+void countedCall() {
+    INSTRUMENT_COUNT("test.count");
+}
+
+void timedCall() {
+    INSTRUMENT_SCOPE("test.scope");
+}
+
+std::string dump() {
+    std::ostringstream os;
+    instrument::dumpJson(os);
+    return os.str();
+}
+
+bool reports(const std::string& json, const std::string& name, unsigned long long count) {
+    return json.find("\"name\":\"" + name + "\",\"count\":" + std::to_string(count) + ",") != std::string::npos ||
+           json.find("\"name\":\"" + name + "\",\"count\":" + std::to_string(count) + "}") != std::string::npos;
+}
+
+}  // namespace
+
+TEST(Instrument, BucketsCoverTheClampedRange) {
+    EXPECT_EQ(instrument::bucketFor(0), 0);
+    EXPECT_EQ(instrument::bucketFor(31), 31);
+    EXPECT_EQ(instrument::bucketLowerBound(instrument::bucketFor(1000)), 992u);
+    EXPECT_EQ(instrument::bucketFor((uint64_t(1) << instrument::kMaxValueBits) - 1), instrument::kBuckets - 1);
+    EXPECT_EQ(instrument::bucketFor(~uint64_t(0)), instrument::kBuckets - 1);
+}
+
+TEST(Instrument, CountsAreExactThoughOnlySampled) {
+    instrument::reset();
+    for (int i = 0; i < 1000; ++i) countedCall();
+    for (int i = 0; i < 33; ++i) timedCall();
+    std::string json = dump();
+    EXPECT_TRUE(reports(json, "test.count", 1000)) << json;
+    EXPECT_TRUE(reports(json, "test.scope", 33)) << json;
+    // Calls 1, 17 and 33 are the sampled ones.
+    EXPECT_NE(json.find("\"samples\":3,"), std::string::npos) << json;
+}
+
+TEST(Instrument, ExitedThreadsAreKeptAndTheirSlotsReused) {
+    instrument::reset();
+    instrument::ThreadStats* first = nullptr;
+    instrument::ThreadStats* second = nullptr;
+    std::thread([&] {
+        for (int i = 0; i < 100; ++i) countedCall();
+        first = instrument::currentThreadStats;
+    }).join();
+    std::thread([&] {
+        for (int i = 0; i < 50; ++i) countedCall();
+        second = instrument::currentThreadStats;
+    }).join();
+    EXPECT_EQ(first, second);
+    EXPECT_TRUE(reports(dump(), "test.count", 150));
+}
@@ -0,0 +1,86 @@
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mvcc/mvcc.h"
+
+namespace {
+
+std::vector<int> visible(const mvcc::AppendLog<int>& log, const mvcc::Snapshot& snapshot) {
+    std::vector<int> values;
+    log.forEach(snapshot, [&](int value) { values.push_back(value); });
+    return values;
+}
+
+}  // namespace
+
+TEST(AppendLog, SnapshotSeesOnlyCommittedEntries) {
+    mvcc::Domain domain;
+    mvcc::AppendLog<int> log;
+    for (int i = 0; i < 10; ++i) {
+        mvcc::Write write(domain);
+        log.append(write, i);
+        write.commit();
+    }
+    mvcc::Snapshot before(domain);
+    {
+        mvcc::Write write(domain);
+        log.append(write, 10);
+        write.commit();
+    }
+    mvcc::Snapshot after(domain);
+
+    EXPECT_EQ(visible(log, before).size(), 10u);
+    EXPECT_EQ(visible(log, after).size(), 11u);
+    EXPECT_EQ(log.size(), 11u);
+    std::vector<int> latest;
+    log.forEach([&](int value) { latest.push_back(value); });
+    EXPECT_EQ(latest, visible(log, after));
+}
+
+TEST(AppendLog, FindFirstStopsAtFirstMatch) {
+    mvcc::Domain domain;
+    mvcc::AppendLog<int*> log;
+    int values[] = {1, 2, 3, 2};
+    for (int& value : values) {
+        mvcc::Write write(domain);
+        log.append(write, &value);
+        write.commit();
+    }
+    int visited = 0;
+    int* found = log.findFirst([&](const int* value) { ++visited; return *value == 2; });
+    EXPECT_EQ(found, &values[1]);
+    EXPECT_EQ(visited, 2);
+    EXPECT_EQ(log.findFirst([](const int* value) { return *value == 5; }), nullptr);
+}
+
+TEST(Write, UnwoundWriteDoesNotCommit) {
+    mvcc::Domain domain;
+    mvcc::Versioned<int> cell(1);
+    uint64_t version = domain.currentVersion();
+    try {
+        mvcc::Write write(domain);
+        cell.set(write, 2);
+        throw std::runtime_error("writer failed");
+    } catch (const std::runtime_error&) {
+    }
+    EXPECT_EQ(domain.currentVersion(), version);
+    mvcc::Snapshot snapshot(domain);
+    EXPECT_EQ(cell.get(snapshot), 1);
+}
+
+TEST(Versioned, SnapshotKeepsItsVersion) {
+    mvcc::Domain domain;
+    mvcc::Versioned<int> cell(0);
+    mvcc::Snapshot pinned(domain);
+    for (int i = 1; i <= 1000; ++i) {
+        mvcc::Write write(domain);
+        cell.set(write, i);
+        write.commit();
+    }
+    EXPECT_EQ(cell.get(pinned), 0);
+    EXPECT_EQ(cell.latest(), 1000);
+    mvcc::Snapshot now(domain);
+    EXPECT_EQ(cell.get(now), 1000);
+}
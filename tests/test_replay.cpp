@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "replay/replay.h"
+
+using replay::Command;
+using replay::Trace;
+
+namespace {
+
+// Writes text to a uniquely named temporary trace file that is removed with
+// the object, so cases running in parallel processes do not collide.
+class TraceFile {
+private:
+    std::string path;
+
+public:
+    explicit TraceFile(const std::string& text) : path(testing::TempDir() + "replay_test.XXXXXX") {
+        int fd = mkstemp(&path[0]);
+        if (fd < 0) throw std::runtime_error("mkstemp failed for " + path);
+        close(fd);
+        std::ofstream out(path);
+        out << text;
+    }
+    ~TraceFile() { std::remove(path.c_str()); }
+
+    const char* getPath() const { return path.c_str(); }
+};
+
+}  // namespace
+
+TEST(Trace, CountsEveryToken) {
+    TraceFile file("enroll 1 2 3\nbook a b c d e f g h i j\n");
+    Trace trace;
+    std::string error;
+    ASSERT_TRUE(trace.open(file.getPath(), error)) << error;
+
+    Command command;
+    ASSERT_TRUE(trace.next(command));
+    EXPECT_EQ(command.argc, 3);
+    ASSERT_TRUE(trace.next(command));
+    EXPECT_EQ(command.argc, 10);
+    EXPECT_EQ(command.tail(7), "h i j");
+    EXPECT_THROW(replay::stringArg(command, 8), std::invalid_argument);
+    EXPECT_FALSE(trace.next(command));
+}
+
+TEST(Trace, ArityChecks) {
+    TraceFile file("enroll 1 2 3\nenroll 1 2\nstudent 7 Ada Lovelace\nstudent 7\n");
+    Trace trace;
+    std::string error;
+    ASSERT_TRUE(trace.open(file.getPath(), error)) << error;
+
+    Command command;
+    ASSERT_TRUE(trace.next(command));
+    EXPECT_THROW(replay::expectArgs(command, 2), std::invalid_argument);
+    ASSERT_TRUE(trace.next(command));
+    EXPECT_NO_THROW(replay::expectArgs(command, 2));
+    ASSERT_TRUE(trace.next(command));
+    EXPECT_NO_THROW(replay::expectTailArgs(command, 2));
+    EXPECT_EQ(replay::tailArg(command, 1), "Ada Lovelace");
+    ASSERT_TRUE(trace.next(command));
+    EXPECT_THROW(replay::expectTailArgs(command, 2), std::invalid_argument);
+}
+
+TEST(Replay, MalformedCommandFails) {
+    TraceFile file("enroll 1 2\nenroll 1 2 3\n");
+    replay::NullStream sink;
+    int executed = 0;
+    int status = replay::run(file.getPath(), [&](const Command& command) {
+        replay::expectArgs(command, 2);
+        ++executed;
+        return true;
+    }, sink);
+    EXPECT_EQ(status, 1);
+    EXPECT_EQ(executed, 1);
+}
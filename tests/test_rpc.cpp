@@ -0,0 +1,159 @@
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "rpc/client.h"
+
+using rpc::Client;
+using rpc::Op;
+using rpc::Reply;
+using rpc::Response;
+using rpc::Writer;
+
+namespace {
+
+// Runs rpc_server on a temporary Unix socket in a child process, so the test
+// talks to the shipped binary over the wire.
+class ServerTest : public testing::Test {
+protected:
+    std::string path;
+    pid_t pid = -1;
+
+    void SetUp() override {
+        // ctest runs each case in its own process, possibly in parallel.
+        const testing::TestInfo* test = testing::UnitTest::GetInstance()->current_test_info();
+        path = testing::TempDir() + "rpc_test." + std::to_string(getpid()) + "." + test->name() + ".sock";
+        unlink(path.c_str());
+        std::string server = RPC_SERVER_PATH;
+        char* argv[] = {const_cast<char*>(server.c_str()), const_cast<char*>("--unix"), const_cast<char*>(path.c_str()),
+                        const_cast<char*>("--workers"), const_cast<char*>("2"), nullptr};
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        ASSERT_EQ(posix_spawn(&pid, server.c_str(), &actions, nullptr, argv, environ), 0);
+        posix_spawn_file_actions_destroy(&actions);
+        for (int attempt = 0; attempt < 500 && access(path.c_str(), F_OK) != 0; ++attempt) usleep(10000);
+        ASSERT_EQ(access(path.c_str(), F_OK), 0) << "rpc_server did not create " << path;
+    }
+
+    void TearDown() override {
+        if (pid <= 0) return;
+        kill(pid, SIGTERM);
+        int status;
+        waitpid(pid, &status, 0);
+    }
+
+    void connect(Client& client) {
+        std::string error;
+        ASSERT_TRUE(client.connectUnix(path, error)) << error;
+    }
+};
+
+std::string intBody(int32_t a) {
+    std::string body;
+    Writer writer(body);
+    writer.putI32(a);
+    return body;
+}
+
+std::string intBody(int32_t a, int32_t b) {
+    std::string body = intBody(a);
+    Writer(body).putI32(b);
+    return body;
+}
+
+std::string namedBody(int32_t key, const std::string& name) {
+    std::string body = intBody(key);
+    Writer(body).putString(name);
+    return body;
+}
+
+}  // namespace
+
+TEST_F(ServerTest, MalformedFrameChangesNothing) {
+    Client client;
+    connect(client);
+    client.send(1, Op::AddStudent, namedBody(1, "Ada"));
+    client.send(2, Op::AddSubject, namedBody(10, "Maths"));
+    client.send(3, Op::Enroll, intBody(1, 10) + "junk");
+    client.send(4, Op::AddStudent, namedBody(2, "Bob") + "x");
+    client.send(5, Op::StudentSubjects, intBody(2));
+    client.send(6, Op::StudentSubjects, intBody(1));
+    ASSERT_TRUE(client.flush());
+
+    // Student 2 was never added and student 1 has no subjects.
+    Reply expected[] = {Reply::Ok, Reply::Ok, Reply::BadRequest, Reply::BadRequest, Reply::Rejected, Reply::Ok};
+    Response response;
+    for (uint32_t id = 1; id <= 6; ++id) {
+        ASSERT_TRUE(client.receive(response));
+        EXPECT_EQ(response.id, id);
+        EXPECT_EQ(response.reply, expected[id - 1]) << "request " << id;
+    }
+    EXPECT_EQ(response.body, std::string(4, '\0'));
+}
+
+TEST_F(ServerTest, OversizedRosterIsRejected) {
+    Client client;
+    connect(client);
+    const int32_t students = 300;
+    const std::string name(4000, 'n');
+    client.send(1, Op::AddSubject, namedBody(10, "Maths"));
+    for (int32_t roll = 1; roll <= students; ++roll) {
+        client.send(2 * roll, Op::AddStudent, namedBody(roll, name));
+        client.send(2 * roll + 1, Op::Enroll, intBody(roll, 10));
+    }
+    client.send(1000, Op::SubjectStudents, intBody(10));
+    ASSERT_TRUE(client.flush());
+
+    // The roster would be about 1.2 MB, past kMaxFrame.
+    Response response;
+    for (int32_t i = 0; i <= 2 * students; ++i) {
+        ASSERT_TRUE(client.receive(response));
+        EXPECT_EQ(response.reply, Reply::Ok) << "request " << response.id;
+    }
+    ASSERT_TRUE(client.receive(response));
+    EXPECT_EQ(response.id, 1000u);
+    EXPECT_EQ(response.reply, Reply::Rejected);
+    EXPECT_TRUE(response.body.empty());
+}
+
+TEST_F(ServerTest, AnswersAfterHalfClose) {
+    std::string output;
+    for (uint32_t id = 1; id <= 100; ++id) {
+        Writer writer(output);
+        writer.beginFrame(id, static_cast<uint8_t>(Op::AddStudent));
+        writer.putI32(static_cast<int32_t>(id));
+        writer.putString("Student");
+        writer.endFrame();
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path.c_str());
+    ASSERT_EQ(::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_EQ(write(fd, output.data(), output.size()), static_cast<ssize_t>(output.size()));
+    shutdown(fd, SHUT_WR);
+
+    // The server answers every request and then closes its side.
+    std::string input;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0) input.append(buffer, static_cast<size_t>(n));
+    close(fd);
+
+    size_t responses = 0;
+    for (size_t offset = 0; offset + 4 <= input.size(); offset += 4 + rpc::peekLength(input.data() + offset)) ++responses;
+    EXPECT_EQ(responses, 100u);
+}